@@ -0,0 +1,30 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+struct Shape;
+
+struct Square;
+
+struct Shape {
+    void *self;
+    int32_t (*area)(void *self);
+};
+
+struct Square {
+    int32_t side;
+};
+
+extern int32_t counter;
+struct Shape *__make_Shape_value(struct Shape value);
+
+struct Square *__make_Square_value(struct Square value);
+
+int32_t main();
+
+int32_t pSquare__area(struct Square *self);
+
+struct Shape *make_square__0_side(int32_t side);
+
+void *malloc(uint64_t size);
+
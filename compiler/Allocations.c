@@ -0,0 +1,43 @@
+/* Copyright (C) 2024 Stefan Selariu */
+
+/*
+ * Counts the heap allocations of a compiler run, and reports them at exit.
+ * Enabled by building with: -DALLOCATIONS__COUNT -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc
+ */
+#ifdef ALLOCATIONS__COUNT
+
+#include "Builtins.h"
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *pointer, size_t size);
+
+static size_t allocations_count = 0;
+
+static void Allocations__report() {
+    fprintf(stderr, "Allocations: %zu\n", allocations_count);
+}
+
+/* The worker threads allocate too */
+static void Allocations__count() {
+    if (__atomic_fetch_add(&allocations_count, 1, __ATOMIC_RELAXED) == 0) {
+        atexit(Allocations__report);
+    }
+}
+
+void *__wrap_malloc(size_t size) {
+    Allocations__count();
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    Allocations__count();
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *pointer, size_t size) {
+    Allocations__count();
+    return __real_realloc(pointer, size);
+}
+
+#endif
@@ -0,0 +1,94 @@
+/* Copyright (C) 2024 Stefan Selariu */
+
+#include "Arena.h"
+
+#define ARENA_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGNMENT 8
+
+struct Arena_Block {
+    Arena_Block *prev_block;
+};
+
+Arena *Arena__create() {
+    Arena *arena = (Arena *)malloc(sizeof(Arena));
+    arena->last_block = NULL;
+    arena->next_byte = NULL;
+    arena->end_byte = NULL;
+    return arena;
+}
+
+static Arena_Block *Arena_Block__create(Arena_Block *prev_block, size_t data_size) {
+    Arena_Block *block = (Arena_Block *)malloc(sizeof(Arena_Block) + data_size);
+    if (block == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        panic();
+    }
+    block->prev_block = prev_block;
+    return block;
+}
+
+void *Arena__allocate(Arena *self, size_t size) {
+    size = (size + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1);
+
+    if (size > (size_t)(self->end_byte - self->next_byte)) {
+        if (size > ARENA_BLOCK_SIZE / 4 && self->last_block != NULL) {
+            /* Big allocations get their own block, which is kept behind the current one */
+            Arena_Block *block = Arena_Block__create(self->last_block->prev_block, size);
+            self->last_block->prev_block = block;
+            return (void *)(block + 1);
+        }
+
+        size_t data_size = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+        Arena_Block *block = Arena_Block__create(self->last_block, data_size);
+        self->last_block = block;
+        self->next_byte = (char *)(block + 1);
+        self->end_byte = self->next_byte + data_size;
+    }
+
+    void *result = self->next_byte;
+    self->next_byte = self->next_byte + size;
+    return result;
+}
+
+void Arena__release(Arena *self) {
+    Arena_Block *block = self->last_block;
+    while (block != NULL) {
+        Arena_Block *prev_block = block->prev_block;
+        free(block);
+        block = prev_block;
+    }
+    self->last_block = NULL;
+    self->next_byte = NULL;
+    self->end_byte = NULL;
+}
+
+void Arena__adopt(Arena *self, Arena *other) {
+    if (other->last_block != NULL) {
+        if (self->last_block == NULL) {
+            self->last_block = other->last_block;
+            self->next_byte = other->next_byte;
+            self->end_byte = other->end_byte;
+        } else {
+            /* The other blocks are kept behind the current one */
+            Arena_Block *first_block = other->last_block;
+            while (first_block->prev_block != NULL) {
+                first_block = first_block->prev_block;
+            }
+            first_block->prev_block = self->last_block->prev_block;
+            self->last_block->prev_block = other->last_block;
+        }
+    }
+    free(other);
+}
+
+_Thread_local Arena *source_arena = NULL;
+_Thread_local Arena *parse_arena = NULL;
+_Thread_local Arena *check_arena = NULL;
+_Thread_local Arena *generate_arena = NULL;
+
+void Arena__init() {
+    source_arena = Arena__create();
+    parse_arena = Arena__create();
+    check_arena = Arena__create();
+    generate_arena = Arena__create();
+}
@@ -0,0 +1,35 @@
+/* Copyright (C) 2024 Stefan Selariu */
+
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include "Builtins.h"
+
+typedef struct Arena_Block Arena_Block;
+
+typedef struct Arena {
+    Arena_Block *last_block;
+    char *next_byte;
+    char *end_byte;
+} Arena;
+
+Arena *Arena__create();
+void *Arena__allocate(Arena *self, size_t size);
+void Arena__release(Arena *self);
+
+/* Takes over the blocks of the other arena, which is destroyed */
+void Arena__adopt(Arena *self, Arena *other);
+
+/* Each thread allocates from its own phase arenas */
+
+/* Sources, locations and names are referenced by every phase */
+extern _Thread_local Arena *source_arena;
+/* Tokens and parsed nodes are released as soon as the source is checked */
+extern _Thread_local Arena *parse_arena;
+extern _Thread_local Arena *check_arena;
+extern _Thread_local Arena *generate_arena;
+
+/* Creates the phase arenas of the calling thread */
+void Arena__init();
+
+#endif
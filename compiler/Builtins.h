@@ -10,12 +10,12 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define panic()                                                              \
-    fprintf(stderr, "%s:%d: \033[0;91mPanic!\033[0m\n", __FILE__, __LINE__); \
-    exit(1);
+/* Both exit the process, or only the current task when called from a worker task */
+void Builtins__panic(const char *file, int line) __attribute__((noreturn));
+void Builtins__todo(const char *file, int line, const char *message) __attribute__((noreturn));
 
-#define todo(message)                                                                   \
-    fprintf(stderr, "%s:%d: \033[0;95mTODO: %s\033[0m\n", __FILE__, __LINE__, message); \
-    exit(1);
+#define panic() Builtins__panic(__FILE__, __LINE__)
+
+#define todo(message) Builtins__todo(__FILE__, __LINE__, message)
 
 #endif
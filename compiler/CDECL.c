@@ -1,6 +1,7 @@
 /* Copyright (C) 2024 Stefan Selariu */
 
 #include "CDECL.h"
+#include "Arena.h"
 #include "File.h"
 
 typedef struct CDECL {
@@ -10,7 +11,7 @@ typedef struct CDECL {
 } CDECL;
 
 CDECL *CDECL__create() {
-    CDECL *cdecl = malloc(sizeof(CDECL));
+    CDECL *cdecl = (CDECL *)Arena__allocate(generate_arena, sizeof(CDECL));
     cdecl->type = NULL;
     cdecl->left = NULL;
     cdecl->right = NULL;
@@ -19,43 +20,105 @@ CDECL *CDECL__create() {
 
 void declare(CDECL *cdecl, Checked_Type *symbol_type);
 
-void String__append_cdecl(String *self, String *name, Checked_Type *type) {
+/*
+ * The declarator of a type is rendered once and cached by type. Pointer, array and function
+ * pointer types are unique, so this caches them per canonical type, while function types
+ * keep their parameter names and are cached per instance.
+ */
+typedef struct CDECL_Cache_Entry {
+    Checked_Type *type;
+    /* The type followed by the left part of the declarator, separated by a space */
+    String *head;
+    bool has_left;
+    String *right;
+} CDECL_Cache_Entry;
+
+/* Each thread has its own cache */
+static _Thread_local CDECL_Cache_Entry *cdecl_cache = NULL;
+static _Thread_local size_t cdecl_cache_size = 0;
+static _Thread_local size_t cdecl_cache_count = 0;
+
+static CDECL_Cache_Entry *CDECL__find_cache_entry(Checked_Type *type) {
+    size_t index = (((uintptr_t)type >> 3) * 2654435761u) & (cdecl_cache_size - 1);
+    while (cdecl_cache[index].type != NULL && cdecl_cache[index].type != type) {
+        index = (index + 1) & (cdecl_cache_size - 1);
+    }
+    return &cdecl_cache[index];
+}
+
+static void CDECL__grow_cache() {
+    CDECL_Cache_Entry *old_cache = cdecl_cache;
+    size_t old_cache_size = cdecl_cache_size;
+
+    cdecl_cache_size = old_cache_size == 0 ? 256 : old_cache_size * 2;
+    cdecl_cache = (CDECL_Cache_Entry *)Arena__allocate(generate_arena, cdecl_cache_size * sizeof(CDECL_Cache_Entry));
+    memset(cdecl_cache, 0, cdecl_cache_size * sizeof(CDECL_Cache_Entry));
+    for (size_t index = 0; index < old_cache_size; index++) {
+        if (old_cache[index].type != NULL) {
+            *CDECL__find_cache_entry(old_cache[index].type) = old_cache[index];
+        }
+    }
+}
+
+static CDECL_Cache_Entry *CDECL__get(Checked_Type *type) {
+    if (cdecl_cache_size > 0) {
+        CDECL_Cache_Entry *entry = CDECL__find_cache_entry(type);
+        if (entry->type != NULL) {
+            return entry;
+        }
+    }
+
+    /* Declaring a function type caches its parameter types, so the entry is claimed after */
     CDECL cdecl = {NULL, NULL, NULL};
     declare(&cdecl, type);
-    String__append_string(self, cdecl.type);
-    String__delete(cdecl.type);
-    String__append_char(self, ' ');
+    if ((cdecl_cache_count + 1) * 2 > cdecl_cache_size) {
+        CDECL__grow_cache();
+    }
+    CDECL_Cache_Entry *entry = CDECL__find_cache_entry(type);
     if (cdecl.left != NULL) {
-        String__append_string(self, cdecl.left);
+        String__append_char(cdecl.type, ' ');
+        String__append_string(cdecl.type, cdecl.left);
         String__delete(cdecl.left);
     }
-    if (name != NULL) {
-        String__append_string(self, name);
-    }
+    entry->type = type;
+    entry->head = String__create_copy_in(cdecl.type, generate_arena);
+    entry->has_left = cdecl.left != NULL;
+    String__delete(cdecl.type);
     if (cdecl.right != NULL) {
-        String__append_string(self, cdecl.right);
+        entry->right = String__create_copy_in(cdecl.right, generate_arena);
         String__delete(cdecl.right);
+    } else {
+        entry->right = NULL;
     }
+    cdecl_cache_count = cdecl_cache_count + 1;
+    return entry;
 }
 
-void pWriter__write__cdecl(Writer *writer, String *name, Checked_Type *type) {
-    CDECL cdecl = {NULL, NULL, NULL};
-    declare(&cdecl, type);
-    pWriter__write__string(writer, cdecl.type);
-    String__delete(cdecl.type);
-    if (cdecl.left != NULL || name != NULL) {
-        pWriter__write__char(writer, ' ');
+void String__append_cdecl(String *self, String *name, Checked_Type *type) {
+    CDECL_Cache_Entry *cdecl = CDECL__get(type);
+    String__append_string(self, cdecl->head);
+    if (!cdecl->has_left) {
+        String__append_char(self, ' ');
     }
-    if (cdecl.left != NULL) {
-        pWriter__write__string(writer, cdecl.left);
-        String__delete(cdecl.left);
+    if (name != NULL) {
+        String__append_string(self, name);
+    }
+    if (cdecl->right != NULL) {
+        String__append_string(self, cdecl->right);
     }
+}
+
+void pWriter__write__cdecl(Writer *writer, String *name, Checked_Type *type) {
+    CDECL_Cache_Entry *cdecl = CDECL__get(type);
+    pWriter__write__string(writer, cdecl->head);
     if (name != NULL) {
+        if (!cdecl->has_left) {
+            pWriter__write__char(writer, ' ');
+        }
         pWriter__write__string(writer, name);
     }
-    if (cdecl.right != NULL) {
-        pWriter__write__string(writer, cdecl.right);
-        String__delete(cdecl.right);
+    if (cdecl->right != NULL) {
+        pWriter__write__string(writer, cdecl->right);
     }
 }
 
@@ -2,9 +2,20 @@
 
 #include "Char.h"
 
+#if !defined(CHAR__SCALAR) && defined(__AVX2__)
+#include <immintrin.h>
+#define CHAR__BLOCK_SIZE 32
+#elif !defined(CHAR__SCALAR) && defined(__SSE2__)
+#include <emmintrin.h>
+#define CHAR__BLOCK_SIZE 16
+#endif
+
+#ifdef CHAR__SCALAR
+
 bool char_is_end_of_line(char c) {
     return c == '\n' || c == '\0';
 }
+
 bool char_is_digit(char c) {
     return c >= '0' && c <= '9';
 }
@@ -21,6 +32,68 @@ bool char_is_space(char c) {
     return c == ' ';
 }
 
+uint8_t char_class(char c) {
+    uint8_t result = 0;
+    if (char_is_digit(c)) {
+        result = result | CHAR_CLASS__DIGIT;
+    }
+    if (char_is_end_of_line(c)) {
+        result = result | CHAR_CLASS__END_OF_LINE;
+    }
+    if (char_is_identifier_start(c)) {
+        result = result | CHAR_CLASS__IDENTIFIER_START;
+    }
+    if (char_is_identifier_letter(c)) {
+        result = result | CHAR_CLASS__IDENTIFIER_LETTER;
+    }
+    if (char_is_space(c)) {
+        result = result | CHAR_CLASS__SPACE;
+    }
+    return result;
+}
+
+#else
+
+#define D CHAR_CLASS__DIGIT | CHAR_CLASS__IDENTIFIER_LETTER
+#define L CHAR_CLASS__IDENTIFIER_START | CHAR_CLASS__IDENTIFIER_LETTER
+
+const uint8_t char_classes[256] = {
+    ['\0'] = CHAR_CLASS__END_OF_LINE,
+    ['\n'] = CHAR_CLASS__END_OF_LINE,
+    [' '] = CHAR_CLASS__SPACE,
+    ['0'] = D, ['1'] = D, ['2'] = D, ['3'] = D, ['4'] = D, ['5'] = D, ['6'] = D, ['7'] = D, ['8'] = D, ['9'] = D,
+    ['A'] = L, ['B'] = L, ['C'] = L, ['D'] = L, ['E'] = L, ['F'] = L, ['G'] = L, ['H'] = L, ['I'] = L, ['J'] = L, ['K'] = L, ['L'] = L, ['M'] = L,
+    ['N'] = L, ['O'] = L, ['P'] = L, ['Q'] = L, ['R'] = L, ['S'] = L, ['T'] = L, ['U'] = L, ['V'] = L, ['W'] = L, ['X'] = L, ['Y'] = L, ['Z'] = L,
+    ['_'] = L,
+    ['a'] = L, ['b'] = L, ['c'] = L, ['d'] = L, ['e'] = L, ['f'] = L, ['g'] = L, ['h'] = L, ['i'] = L, ['j'] = L, ['k'] = L, ['l'] = L, ['m'] = L,
+    ['n'] = L, ['o'] = L, ['p'] = L, ['q'] = L, ['r'] = L, ['s'] = L, ['t'] = L, ['u'] = L, ['v'] = L, ['w'] = L, ['x'] = L, ['y'] = L, ['z'] = L,
+};
+
+#undef D
+#undef L
+
+bool char_is_end_of_line(char c) {
+    return char_has_class(c, CHAR_CLASS__END_OF_LINE);
+}
+
+bool char_is_digit(char c) {
+    return char_has_class(c, CHAR_CLASS__DIGIT);
+}
+
+bool char_is_identifier_start(char c) {
+    return char_has_class(c, CHAR_CLASS__IDENTIFIER_START);
+}
+
+bool char_is_identifier_letter(char c) {
+    return char_has_class(c, CHAR_CLASS__IDENTIFIER_LETTER);
+}
+
+bool char_is_space(char c) {
+    return char_has_class(c, CHAR_CLASS__SPACE);
+}
+
+#endif
+
 char escape_char_value(char c) {
     if (c == 'n') {
         return '\n';
@@ -45,3 +118,104 @@ char escape_char_value(char c) {
     }
     return (char)-1;
 }
+
+typedef enum Char_Run {
+    CHAR_RUN__IDENTIFIER_LETTERS,
+    CHAR_RUN__LINE,
+    CHAR_RUN__SPACES
+} Char_Run;
+
+#ifdef CHAR__BLOCK_SIZE
+
+#if CHAR__BLOCK_SIZE == 32
+typedef __m256i Char_Block;
+#define char_block_load(block) _mm256_load_si256((const __m256i *)(block))
+#define char_block_set(c) _mm256_set1_epi8((char)(c))
+#define char_block_or(a, b) _mm256_or_si256(a, b)
+#define char_block_add(a, b) _mm256_add_epi8(a, b)
+#define char_block_equals(a, b) _mm256_cmpeq_epi8(a, b)
+#define char_block_less(a, b) _mm256_cmpgt_epi8(b, a)
+#define char_block_mask(a) ((uint32_t)_mm256_movemask_epi8(a))
+#else
+typedef __m128i Char_Block;
+#define char_block_load(block) _mm_load_si128((const __m128i *)(block))
+#define char_block_set(c) _mm_set1_epi8((char)(c))
+#define char_block_or(a, b) _mm_or_si128(a, b)
+#define char_block_add(a, b) _mm_add_epi8(a, b)
+#define char_block_equals(a, b) _mm_cmpeq_epi8(a, b)
+#define char_block_less(a, b) _mm_cmplt_epi8(a, b)
+#define char_block_mask(a) ((uint32_t)_mm_movemask_epi8(a))
+#endif
+
+/* Marks the chars between first and last, by shifting the range to the bottom of the signed chars */
+static Char_Block char_block_in_range(Char_Block chars, uint8_t first, uint8_t last) {
+    Char_Block shifted = char_block_add(chars, char_block_set(0x80 - first));
+    return char_block_less(shifted, char_block_set(0x80 + (last - first + 1)));
+}
+
+/* Returns a bit for each char of the block that ends the run */
+static uint32_t char_block_run_end_mask(const char *block, Char_Run run) {
+    Char_Block chars = char_block_load(block);
+    switch (run) {
+    case CHAR_RUN__IDENTIFIER_LETTERS: {
+        Char_Block letters = char_block_in_range(char_block_or(chars, char_block_set(0x20)), 'a', 'z');
+        Char_Block digits = char_block_in_range(chars, '0', '9');
+        Char_Block underscores = char_block_equals(chars, char_block_set('_'));
+        return ~char_block_mask(char_block_or(char_block_or(letters, digits), underscores));
+    }
+    case CHAR_RUN__LINE:
+        return char_block_mask(char_block_or(char_block_equals(chars, char_block_set('\n')), char_block_equals(chars, char_block_set('\0'))));
+    case CHAR_RUN__SPACES:
+        return ~char_block_mask(char_block_equals(chars, char_block_set(' ')));
+    }
+    return 0;
+}
+
+static size_t chars_skip_run(const char *data, size_t index, Char_Run run) {
+    const char *block = (const char *)((uintptr_t)(data + index) & ~(uintptr_t)(CHAR__BLOCK_SIZE - 1));
+    uint32_t block_mask = (uint32_t)(((uint64_t)1 << CHAR__BLOCK_SIZE) - 1);
+    /* Chars before the index don't count */
+    uint32_t end_mask = char_block_run_end_mask(block, run) & (block_mask << (data + index - block)) & block_mask;
+    while (end_mask == 0) {
+        block = block + CHAR__BLOCK_SIZE;
+        end_mask = char_block_run_end_mask(block, run) & block_mask;
+    }
+    return (size_t)(block - data) + (size_t)__builtin_ctz(end_mask);
+}
+
+#else
+
+static size_t chars_skip_run(const char *data, size_t index, Char_Run run) {
+    switch (run) {
+    case CHAR_RUN__IDENTIFIER_LETTERS:
+        while (char_is_identifier_letter(data[index])) {
+            index = index + 1;
+        }
+        break;
+    case CHAR_RUN__LINE:
+        while (!char_is_end_of_line(data[index])) {
+            index = index + 1;
+        }
+        break;
+    case CHAR_RUN__SPACES:
+        while (char_is_space(data[index])) {
+            index = index + 1;
+        }
+        break;
+    }
+    return index;
+}
+
+#endif
+
+size_t chars_skip_identifier_letters(const char *data, size_t index) {
+    return chars_skip_run(data, index, CHAR_RUN__IDENTIFIER_LETTERS);
+}
+
+size_t chars_skip_spaces(const char *data, size_t index) {
+    return chars_skip_run(data, index, CHAR_RUN__SPACES);
+}
+
+size_t chars_skip_line(const char *data, size_t index) {
+    return chars_skip_run(data, index, CHAR_RUN__LINE);
+}
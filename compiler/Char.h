@@ -5,6 +5,27 @@
 
 #include "Builtins.h"
 
+#define CHAR_CLASS__DIGIT 0x01
+#define CHAR_CLASS__END_OF_LINE 0x02
+#define CHAR_CLASS__IDENTIFIER_START 0x04
+#define CHAR_CLASS__IDENTIFIER_LETTER 0x08
+#define CHAR_CLASS__SPACE 0x10
+
+#ifdef CHAR__SCALAR
+
+/* Computed with comparison chains, like the scanner did before the class table */
+uint8_t char_class(char c);
+
+#define char_has_class(c, class) ((char_class(c) & (class)) != 0)
+
+#else
+
+extern const uint8_t char_classes[256];
+
+#define char_has_class(c, class) ((char_classes[(uint8_t)(c)] & (class)) != 0)
+
+#endif
+
 bool char_is_end_of_line(char c);
 
 bool char_is_digit(char c);
@@ -17,4 +38,17 @@ bool char_is_space(char c);
 
 char escape_char_value(char c);
 
+/*
+ * The skip functions return the index of the first char, at or after the given index, that
+ * ends the run. They read whole aligned blocks, so the data must be zero terminated and
+ * readable up to the next 32 byte boundary after the terminator.
+ */
+
+size_t chars_skip_identifier_letters(const char *data, size_t index);
+
+size_t chars_skip_spaces(const char *data, size_t index);
+
+/* Stops at the end of the line or at the end of the data */
+size_t chars_skip_line(const char *data, size_t index);
+
 #endif
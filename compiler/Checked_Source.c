@@ -1,16 +1,141 @@
 /* Copyright (C) 2024 Stefan Selariu */
 
 #include "Checked_Source.h"
+#include "Arena.h"
 #include "File.h"
 
-Checked_Type *Checked_Type__create_kind(Checked_Type_Kind kind, size_t kind_size, Source_Location *location) {
-    Checked_Type *type = (Checked_Type *)malloc(kind_size);
+#include <pthread.h>
+
+Checked_Type *Checked_Type__create_kind(Checked_Type_Kind kind, size_t kind_size, Source_Location location) {
+    Checked_Type *type = (Checked_Type *)Arena__allocate(check_arena, kind_size);
     type->kind = kind;
     type->location = location;
-    type->next_type = NULL;
+    type->canonical_type = type;
+    return type;
+}
+
+/* Unique pointer, array and function pointer types, and canonical function types, shared by all threads */
+static pthread_mutex_t unique_types_mutex = PTHREAD_MUTEX_INITIALIZER;
+static Checked_Type **unique_types_table = NULL;
+static size_t unique_types_table_size = 0;
+static size_t unique_types_count = 0;
+
+static size_t Checked_Type__pointer_hash(void *pointer) {
+    return (size_t)(((uintptr_t)pointer >> 3) * 2654435761u);
+}
+
+static size_t Checked_Type__unique_hash(Checked_Type *self) {
+    size_t hash = (size_t)self->kind + 1;
+    switch (self->kind) {
+    case CHECKED_TYPE_KIND__ARRAY: {
+        Checked_Array_Type *array_type = (Checked_Array_Type *)self;
+        return (hash * 31 + Checked_Type__pointer_hash(array_type->item_type)) * 2 + array_type->is_checked;
+    }
+    case CHECKED_TYPE_KIND__FUNCTION: {
+        Checked_Function_Type *function_type = (Checked_Function_Type *)self;
+        hash = hash * 31 + Checked_Type__pointer_hash(function_type->return_type->canonical_type);
+        for (Checked_Function_Parameter *parameter = function_type->first_parameter; parameter != NULL; parameter = parameter->next_parameter) {
+            hash = hash * 31 + Checked_Type__pointer_hash(parameter->type->canonical_type);
+        }
+        return hash;
+    }
+    case CHECKED_TYPE_KIND__FUNCTION_POINTER:
+        return hash * 31 + Checked_Type__pointer_hash(((Checked_Function_Pointer_Type *)self)->function_type);
+    case CHECKED_TYPE_KIND__POINTER:
+        return hash * 31 + Checked_Type__pointer_hash(((Checked_Pointer_Type *)self)->other_type);
+    default:
+        todo("Handle unexpected Checked_Type_Kind");
+    }
+}
+
+static bool Checked_Type__unique_equals(Checked_Type *self, Checked_Type *other) {
+    if (self->kind != other->kind) {
+        return false;
+    }
+    switch (self->kind) {
+    case CHECKED_TYPE_KIND__ARRAY:
+        return ((Checked_Array_Type *)self)->item_type == ((Checked_Array_Type *)other)->item_type && ((Checked_Array_Type *)self)->is_checked == ((Checked_Array_Type *)other)->is_checked;
+    case CHECKED_TYPE_KIND__FUNCTION: {
+        Checked_Function_Type *self_function_type = (Checked_Function_Type *)self;
+        Checked_Function_Type *other_function_type = (Checked_Function_Type *)other;
+        if (self_function_type->return_type->canonical_type != other_function_type->return_type->canonical_type) {
+            return false;
+        }
+        Checked_Function_Parameter *self_parameter = self_function_type->first_parameter;
+        Checked_Function_Parameter *other_parameter = other_function_type->first_parameter;
+        while (self_parameter != NULL && other_parameter != NULL) {
+            if (self_parameter->type->canonical_type != other_parameter->type->canonical_type) {
+                return false;
+            }
+            self_parameter = self_parameter->next_parameter;
+            other_parameter = other_parameter->next_parameter;
+        }
+        return self_parameter == NULL && other_parameter == NULL;
+    }
+    case CHECKED_TYPE_KIND__FUNCTION_POINTER:
+        return ((Checked_Function_Pointer_Type *)self)->function_type == ((Checked_Function_Pointer_Type *)other)->function_type;
+    case CHECKED_TYPE_KIND__POINTER:
+        return ((Checked_Pointer_Type *)self)->other_type == ((Checked_Pointer_Type *)other)->other_type;
+    default:
+        todo("Handle unexpected Checked_Type_Kind");
+    }
+}
+
+static Checked_Type *Checked_Type__find_unique_locked(Checked_Type *key) {
+    if (unique_types_table == NULL) {
+        return NULL;
+    }
+    size_t index = Checked_Type__unique_hash(key) & (unique_types_table_size - 1);
+    Checked_Type *type;
+    while ((type = unique_types_table[index]) != NULL) {
+        if (Checked_Type__unique_equals(type, key)) {
+            return type;
+        }
+        index = (index + 1) & (unique_types_table_size - 1);
+    }
+    return NULL;
+}
+
+static Checked_Type *Checked_Type__find_unique(Checked_Type *key) {
+    pthread_mutex_lock(&unique_types_mutex);
+    Checked_Type *type = Checked_Type__find_unique_locked(key);
+    pthread_mutex_unlock(&unique_types_mutex);
     return type;
 }
 
+static void Checked_Type__place_unique_locked(Checked_Type *type) {
+    size_t index = Checked_Type__unique_hash(type) & (unique_types_table_size - 1);
+    while (unique_types_table[index] != NULL) {
+        index = (index + 1) & (unique_types_table_size - 1);
+    }
+    unique_types_table[index] = type;
+}
+
+/* Returns the unique type, which is another one if an equal type was inserted in the meantime */
+static Checked_Type *Checked_Type__insert_unique(Checked_Type *type) {
+    pthread_mutex_lock(&unique_types_mutex);
+    Checked_Type *unique_type = Checked_Type__find_unique_locked(type);
+    if (unique_type == NULL) {
+        if ((unique_types_count + 1) * 2 > unique_types_table_size) {
+            Checked_Type **old_table = unique_types_table;
+            size_t old_table_size = unique_types_table_size;
+            unique_types_table_size = old_table_size == 0 ? 256 : old_table_size * 2;
+            unique_types_table = (Checked_Type **)Arena__allocate(check_arena, unique_types_table_size * sizeof(Checked_Type *));
+            memset(unique_types_table, 0, unique_types_table_size * sizeof(Checked_Type *));
+            for (size_t old_index = 0; old_index < old_table_size; old_index++) {
+                if (old_table[old_index] != NULL) {
+                    Checked_Type__place_unique_locked(old_table[old_index]);
+                }
+            }
+        }
+        Checked_Type__place_unique_locked(type);
+        unique_types_count = unique_types_count + 1;
+        unique_type = type;
+    }
+    pthread_mutex_unlock(&unique_types_mutex);
+    return unique_type;
+}
+
 bool Checked_Type__is_numeric_type(Checked_Type *self) {
     switch (self->kind) {
     case CHECKED_TYPE_KIND__I16:
@@ -29,41 +154,44 @@ bool Checked_Type__is_numeric_type(Checked_Type *self) {
     }
 }
 
-Checked_Array_Type *Checked_Array_Type__create(Source_Location *location, Checked_Type *item_type, bool is_checked, Checked_Expression *size_expression) {
-    Checked_Array_Type *type = (Checked_Array_Type *)Checked_Type__create_kind(CHECKED_TYPE_KIND__ARRAY, sizeof(Checked_Array_Type), location);
-    type->item_type = item_type;
-    type->is_checked = is_checked;
-    type->size_expression = size_expression;
-    return type;
-}
-
-bool Checked_Array_Type__equals(Checked_Array_Type *self, Checked_Array_Type *other) {
-    if (self->is_checked != other->is_checked || !Checked_Type__equals(self->item_type, other->item_type)) {
-        return false;
-    }
-    if (self->size_expression == NULL) {
-        return other->size_expression == NULL;
+Checked_Array_Type *Checked_Array_Type__create(Source_Location location, Checked_Type *item_type, bool is_checked, Checked_Expression *size_expression) {
+    if (size_expression != NULL) {
+        Checked_Array_Type *type = (Checked_Array_Type *)Checked_Type__create_kind(CHECKED_TYPE_KIND__ARRAY, sizeof(Checked_Array_Type), location);
+        type->item_type = item_type;
+        type->is_checked = is_checked;
+        type->size_expression = size_expression;
+        return type;
     }
-    if (other->size_expression == NULL) {
-        return false;
+
+    Checked_Array_Type key = {.super = {.kind = CHECKED_TYPE_KIND__ARRAY}, .item_type = item_type, .is_checked = is_checked};
+    Checked_Array_Type *type = (Checked_Array_Type *)Checked_Type__find_unique((Checked_Type *)&key);
+    if (type == NULL) {
+        type = (Checked_Array_Type *)Checked_Type__create_kind(CHECKED_TYPE_KIND__ARRAY, sizeof(Checked_Array_Type), location);
+        type->item_type = item_type;
+        type->is_checked = is_checked;
+        type->size_expression = NULL;
+        if (item_type->canonical_type != item_type) {
+            type->super.canonical_type = (Checked_Type *)Checked_Array_Type__create(location, item_type->canonical_type, is_checked, NULL);
+        }
+        type = (Checked_Array_Type *)Checked_Type__insert_unique((Checked_Type *)type);
     }
-    // TODO: check size expressions
-    panic();
+    return type;
 }
 
-Checked_Named_Type *Checked_Named_Type__create_kind(Checked_Type_Kind kind, size_t kind_size, Source_Location *location, String *name) {
+Checked_Named_Type *Checked_Named_Type__create_kind(Checked_Type_Kind kind, size_t kind_size, Source_Location location, String *name) {
     Checked_Named_Type *type = (Checked_Named_Type *)Checked_Type__create_kind(kind, kind_size, location);
     type->name = name;
+    type->methods = NULL;
     return type;
 }
 
-Checked_External_Type *Checked_External_Type__create(Source_Location *location, String *name) {
+Checked_External_Type *Checked_External_Type__create(Source_Location location, String *name) {
     Checked_External_Type *type = (Checked_External_Type *)Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__EXTERNAL, sizeof(Checked_External_Type), location, name);
     return type;
 }
 
-Checked_Function_Parameter *Checked_Function_Parameter__create(Source_Location *location, String *label, String *name, Checked_Type *type) {
-    Checked_Function_Parameter *parameter = (Checked_Function_Parameter *)malloc(sizeof(Checked_Function_Parameter));
+Checked_Function_Parameter *Checked_Function_Parameter__create(Source_Location location, String *label, String *name, Checked_Type *type) {
+    Checked_Function_Parameter *parameter = (Checked_Function_Parameter *)Arena__allocate(check_arena, sizeof(Checked_Function_Parameter));
     parameter->location = location;
     parameter->label = label;
     parameter->name = name;
@@ -72,84 +200,170 @@ Checked_Function_Parameter *Checked_Function_Parameter__create(Source_Location *
     return parameter;
 }
 
-Checked_Function_Type *Checked_Function_Type__create(Source_Location *location, Checked_Function_Parameter *first_parameter, Checked_Type *return_type) {
+Checked_Function_Type *Checked_Function_Type__create(Source_Location location, Checked_Function_Parameter *first_parameter, Checked_Type *return_type) {
     Checked_Function_Type *type = (Checked_Function_Type *)Checked_Type__create_kind(CHECKED_TYPE_KIND__FUNCTION, sizeof(Checked_Function_Type), location);
     type->first_parameter = first_parameter;
     type->return_type = return_type;
+
+    /* Function types keep their parameter names, so only their canonical type is unique */
+    Checked_Type *canonical_type = Checked_Type__find_unique((Checked_Type *)type);
+    if (canonical_type != NULL) {
+        type->super.canonical_type = canonical_type;
+        return type;
+    }
+    bool is_canonical = return_type->canonical_type == return_type;
+    for (Checked_Function_Parameter *parameter = first_parameter; parameter != NULL; parameter = parameter->next_parameter) {
+        is_canonical = is_canonical && parameter->type->canonical_type == parameter->type;
+    }
+    if (is_canonical) {
+        type->super.canonical_type = Checked_Type__insert_unique((Checked_Type *)type);
+        return type;
+    }
+
+    Checked_Function_Parameter *canonical_first_parameter = NULL;
+    Checked_Function_Parameter *canonical_last_parameter = NULL;
+    for (Checked_Function_Parameter *parameter = first_parameter; parameter != NULL; parameter = parameter->next_parameter) {
+        Checked_Function_Parameter *canonical_parameter = Checked_Function_Parameter__create(parameter->location, parameter->label, parameter->name, parameter->type->canonical_type);
+        if (canonical_last_parameter == NULL) {
+            canonical_first_parameter = canonical_parameter;
+        } else {
+            canonical_last_parameter->next_parameter = canonical_parameter;
+        }
+        canonical_last_parameter = canonical_parameter;
+    }
+    type->super.canonical_type = (Checked_Type *)Checked_Function_Type__create(location, canonical_first_parameter, return_type->canonical_type);
     return type;
 }
 
 bool Checked_Function_Type__equals(Checked_Function_Type *self, Checked_Function_Type *other) {
-    if (!Checked_Type__equals(self->return_type, other->return_type)) {
-        return false;
-    }
-    Checked_Function_Parameter *self_parameter = self->first_parameter;
-    Checked_Function_Parameter *other_parameter = other->first_parameter;
-    while (self_parameter != NULL && other_parameter != NULL) {
-        if (!Checked_Type__equals(self_parameter->type, other_parameter->type)) {
-            return false;
+    return self->super.canonical_type == other->super.canonical_type;
+}
+
+Checked_Function_Pointer_Type *Checked_Function_Pointer_Type__create(Source_Location location, Checked_Function_Type *function_type) {
+    Checked_Function_Pointer_Type key = {.super = {.kind = CHECKED_TYPE_KIND__FUNCTION_POINTER}, .function_type = function_type};
+    Checked_Function_Pointer_Type *type = (Checked_Function_Pointer_Type *)Checked_Type__find_unique((Checked_Type *)&key);
+    if (type == NULL) {
+        type = (Checked_Function_Pointer_Type *)Checked_Type__create_kind(CHECKED_TYPE_KIND__FUNCTION_POINTER, sizeof(Checked_Function_Pointer_Type), location);
+        type->function_type = function_type;
+        if (function_type->super.canonical_type != (Checked_Type *)function_type) {
+            type->super.canonical_type = (Checked_Type *)Checked_Function_Pointer_Type__create(location, (Checked_Function_Type *)function_type->super.canonical_type);
         }
-        self_parameter = self_parameter->next_parameter;
-        other_parameter = other_parameter->next_parameter;
-    }
-    if (self_parameter != NULL || other_parameter != NULL) {
-        return false;
+        type = (Checked_Function_Pointer_Type *)Checked_Type__insert_unique((Checked_Type *)type);
     }
-    return true;
+    return type;
 }
 
-Checked_Function_Pointer_Type *Checked_Function_Pointer_Type__create(Source_Location *location, Checked_Function_Type *function_type) {
-    Checked_Function_Pointer_Type *type = (Checked_Function_Pointer_Type *)Checked_Type__create_kind(CHECKED_TYPE_KIND__FUNCTION_POINTER, sizeof(Checked_Function_Pointer_Type), location);
-    type->function_type = function_type;
+Checked_Pointer_Type *Checked_Pointer_Type__create(Source_Location location, Checked_Type *other_type) {
+    Checked_Pointer_Type key = {.super = {.kind = CHECKED_TYPE_KIND__POINTER}, .other_type = other_type};
+    Checked_Pointer_Type *type = (Checked_Pointer_Type *)Checked_Type__find_unique((Checked_Type *)&key);
+    if (type == NULL) {
+        type = (Checked_Pointer_Type *)Checked_Type__create_kind(CHECKED_TYPE_KIND__POINTER, sizeof(Checked_Pointer_Type), location);
+        type->other_type = other_type;
+        if (other_type->canonical_type != other_type) {
+            type->super.canonical_type = (Checked_Type *)Checked_Pointer_Type__create(location, other_type->canonical_type);
+        }
+        type = (Checked_Pointer_Type *)Checked_Type__insert_unique((Checked_Type *)type);
+    }
     return type;
 }
 
-bool Checked_Function_Pointer_Type__equals(Checked_Function_Pointer_Type *self, Checked_Function_Pointer_Type *other) {
-    return Checked_Function_Type__equals(self->function_type, other->function_type);
-}
+#define CHECKED_STRUCT_TYPE__MAX_UNINDEXED_COUNT 8
 
-Checked_Pointer_Type *Checked_Pointer_Type__create(Source_Location *location, Checked_Type *other_type) {
-    Checked_Pointer_Type *type = (Checked_Pointer_Type *)Checked_Type__create_kind(CHECKED_TYPE_KIND__POINTER, sizeof(Checked_Pointer_Type), location);
-    type->other_type = other_type;
+Checked_Struct_Type *Checked_Struct_Type__create(Source_Location location, String *name) {
+    Checked_Struct_Type *type = (Checked_Struct_Type *)Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__STRUCT, sizeof(Checked_Struct_Type), location, name);
+    type->members = NULL;
+    type->members_count = 0;
+    type->members_size = 0;
+    type->members_table = NULL;
+    type->members_table_size = 0;
+    type->has_layout = false;
+    type->size = 0;
+    type->alignment = 0;
     return type;
 }
 
-bool Checked_Pointer_Type__equals(Checked_Pointer_Type *self, Checked_Pointer_Type *other) {
-    return Checked_Type__equals(self->other_type, other->other_type);
+void Checked_Struct_Type__reserve_members(Checked_Struct_Type *self, size_t members_size) {
+    if (self->members != NULL) {
+        panic();
+    }
+    self->members = (Checked_Struct_Member *)Arena__allocate(check_arena, members_size * sizeof(Checked_Struct_Member));
+    self->members_size = members_size;
+    if (members_size > CHECKED_STRUCT_TYPE__MAX_UNINDEXED_COUNT) {
+        self->members_table_size = 4;
+        while (self->members_table_size < members_size * 2) {
+            self->members_table_size = self->members_table_size * 2;
+        }
+        self->members_table = (Checked_Struct_Member **)Arena__allocate(check_arena, self->members_table_size * sizeof(Checked_Struct_Member *));
+        memset(self->members_table, 0, self->members_table_size * sizeof(Checked_Struct_Member *));
+    }
 }
 
-Checked_Struct_Member *Checked_Struct_Member__create(Source_Location *location, String *name, Checked_Type *type) {
-    Checked_Struct_Member *member = (Checked_Struct_Member *)malloc(sizeof(Checked_Struct_Member));
+Checked_Struct_Member *Checked_Struct_Type__append_member(Checked_Struct_Type *self, Source_Location location, String *name, Checked_Type *type) {
+    if (self->members_count == self->members_size) {
+        panic();
+    }
+    Checked_Struct_Member *member = &self->members[self->members_count];
     member->location = location;
     member->name = name;
     member->type = type;
-    member->next_member = NULL;
-    return member;
-}
+    member->offset = 0;
+    self->members_count = self->members_count + 1;
 
-Checked_Struct_Type *Checked_Struct_Type__create(Source_Location *location, String *name) {
-    Checked_Struct_Type *type = (Checked_Struct_Type *)Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__STRUCT, sizeof(Checked_Struct_Type), location, name);
-    type->first_member = NULL;
-    return type;
+    if (self->members_table != NULL) {
+        size_t index = String__interned_hash(name) & (self->members_table_size - 1);
+        while (self->members_table[index] != NULL) {
+            index = (index + 1) & (self->members_table_size - 1);
+        }
+        self->members_table[index] = member;
+    }
+    return member;
 }
 
 Checked_Struct_Member *Checked_Struct_Type__find_member(Checked_Struct_Type *self, String *name) {
-    Checked_Struct_Member *member = self->first_member;
-    while (member != NULL) {
-        if (String__equals_string(name, member->name)) {
-            break;
+    if (self->members_table != NULL) {
+        size_t index = String__interned_hash(name) & (self->members_table_size - 1);
+        Checked_Struct_Member *member;
+        while ((member = self->members_table[index]) != NULL) {
+            if (member->name == name) {
+                return member;
+            }
+            index = (index + 1) & (self->members_table_size - 1);
         }
-        member = member->next_member;
+        return NULL;
     }
-    return member;
+    for (size_t index = 0; index < self->members_count; index++) {
+        if (self->members[index].name == name) {
+            return &self->members[index];
+        }
+    }
+    return NULL;
 }
 
-bool Checked_Struct_Type__equals(Checked_Struct_Type *self, Checked_Struct_Type *other) {
-    return String__equals_string(self->super.name, other->super.name);
+void Checked_Struct_Type__compute_layout(Checked_Struct_Type *self) {
+    size_t offset = 0;
+    size_t alignment = 1;
+    for (size_t index = 0; index < self->members_count; index++) {
+        Checked_Struct_Member *member = &self->members[index];
+        size_t member_size;
+        size_t member_alignment;
+        if (!Checked_Type__get_layout(member->type, &member_size, &member_alignment)) {
+            self->has_layout = false;
+            return;
+        }
+        offset = (offset + member_alignment - 1) / member_alignment * member_alignment;
+        member->offset = offset;
+        offset = offset + member_size;
+        if (member_alignment > alignment) {
+            alignment = member_alignment;
+        }
+    }
+    self->has_layout = true;
+    self->size = (offset + alignment - 1) / alignment * alignment;
+    self->alignment = alignment;
 }
 
-Checked_Trait_Method *Checked_Trait_Method__create(Source_Location *location, String *name, Checked_Function_Type *function_type, Checked_Struct_Member *struct_member) {
-    Checked_Trait_Method *method = (Checked_Trait_Method *)malloc(sizeof(Checked_Trait_Method));
+Checked_Trait_Method *Checked_Trait_Method__create(Source_Location location, String *name, Checked_Function_Type *function_type, Checked_Struct_Member *struct_member) {
+    Checked_Trait_Method *method = (Checked_Trait_Method *)Arena__allocate(check_arena, sizeof(Checked_Trait_Method));
     method->location = location;
     method->name = name;
     method->function_type = function_type;
@@ -158,7 +372,7 @@ Checked_Trait_Method *Checked_Trait_Method__create(Source_Location *location, St
     return method;
 }
 
-Checked_Trait_Type *Checked_Trait_Type__create(Source_Location *location, String *name) {
+Checked_Trait_Type *Checked_Trait_Type__create(Source_Location location, String *name) {
     Checked_Trait_Type *type = (Checked_Trait_Type *)Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__TRAIT, sizeof(Checked_Trait_Type), location, name);
     type->struct_type = NULL;
     type->self_struct_member = NULL;
@@ -167,25 +381,86 @@ Checked_Trait_Type *Checked_Trait_Type__create(Source_Location *location, String
 }
 
 bool Checked_Type__equals(Checked_Type *self, Checked_Type *other) {
-    if (self == other) {
+    if (self->canonical_type == other->canonical_type) {
         return true;
     }
-    if (self->kind != other->kind) {
-        return false;
+    if (self->kind == CHECKED_TYPE_KIND__ARRAY && other->kind == CHECKED_TYPE_KIND__ARRAY) {
+        Checked_Array_Type *self_array_type = (Checked_Array_Type *)self;
+        Checked_Array_Type *other_array_type = (Checked_Array_Type *)other;
+        if (self_array_type->size_expression != NULL && other_array_type->size_expression != NULL && self_array_type->is_checked == other_array_type->is_checked && Checked_Type__equals(self_array_type->item_type, other_array_type->item_type)) {
+            // TODO: check size expressions
+            panic();
+        }
+    }
+    return false;
+}
+
+size_t Checked_Type__hash(Checked_Type *self) {
+    if (self == NULL) {
+        return 0;
     }
+    return Checked_Type__pointer_hash(self->canonical_type);
+}
+
+bool Checked_Type__get_layout(Checked_Type *self, size_t *size, size_t *alignment) {
     switch (self->kind) {
+    case CHECKED_TYPE_KIND__BOOL:
+    case CHECKED_TYPE_KIND__I8:
+    case CHECKED_TYPE_KIND__U8:
+        *size = 1;
+        break;
+    case CHECKED_TYPE_KIND__I16:
+    case CHECKED_TYPE_KIND__U16:
+        *size = 2;
+        break;
+    case CHECKED_TYPE_KIND__I32:
+    case CHECKED_TYPE_KIND__U32:
+        *size = 4;
+        break;
+    case CHECKED_TYPE_KIND__I64:
+    case CHECKED_TYPE_KIND__U64:
+        *size = 8;
+        break;
+    case CHECKED_TYPE_KIND__ISIZE:
+    case CHECKED_TYPE_KIND__USIZE:
+        *size = sizeof(size_t);
+        break;
     case CHECKED_TYPE_KIND__ARRAY:
-        return Checked_Array_Type__equals((Checked_Array_Type *)self, (Checked_Array_Type *)other);
-    case CHECKED_TYPE_KIND__FUNCTION:
-        return Checked_Function_Type__equals((Checked_Function_Type *)self, (Checked_Function_Type *)other);
     case CHECKED_TYPE_KIND__FUNCTION_POINTER:
-        return Checked_Function_Pointer_Type__equals((Checked_Function_Pointer_Type *)self, (Checked_Function_Pointer_Type *)other);
     case CHECKED_TYPE_KIND__POINTER:
-        return Checked_Pointer_Type__equals((Checked_Pointer_Type *)self, (Checked_Pointer_Type *)other);
-    case CHECKED_TYPE_KIND__STRUCT:
-        return Checked_Struct_Type__equals((Checked_Struct_Type *)self, (Checked_Struct_Type *)other);
+        *size = sizeof(void *);
+        break;
+    case CHECKED_TYPE_KIND__STRUCT: {
+        Checked_Struct_Type *struct_type = (Checked_Struct_Type *)self;
+        *size = struct_type->size;
+        *alignment = struct_type->alignment;
+        return struct_type->has_layout;
+    }
+    case CHECKED_TYPE_KIND__TRAIT:
+        return Checked_Type__get_layout((Checked_Type *)((Checked_Trait_Type *)self)->struct_type, size, alignment);
+    default:
+        return false;
+    }
+    *alignment = *size;
+    return true;
+}
+
+Checked_Named_Type *Checked_Type__base_named_type(Checked_Type *self) {
+    while (true) {
+        switch (self->kind) {
+        case CHECKED_TYPE_KIND__ARRAY:
+            self = ((Checked_Array_Type *)self)->item_type;
+            break;
+        case CHECKED_TYPE_KIND__POINTER:
+            self = ((Checked_Pointer_Type *)self)->other_type;
+            break;
+        case CHECKED_TYPE_KIND__FUNCTION:
+        case CHECKED_TYPE_KIND__FUNCTION_POINTER:
+            return NULL;
+        default:
+            return (Checked_Named_Type *)self;
+        }
     }
-    todo("Handle unexpected Checked_Type_Kind");
 }
 
 void pWriter__write__checked_type(Writer *self, Checked_Type *type) {
@@ -251,8 +526,8 @@ void pWriter__write__checked_type(Writer *self, Checked_Type *type) {
     }
 }
 
-Checked_Symbol *Checked_Symbol__create_kind(Checked_Symbol_Kind kind, size_t kind_size, Source_Location *location, String *name, Checked_Type *type) {
-    Checked_Symbol *symbol = (Checked_Symbol *)malloc(kind_size);
+Checked_Symbol *Checked_Symbol__create_kind(Checked_Symbol_Kind kind, size_t kind_size, Source_Location location, String *name, Checked_Type *type) {
+    Checked_Symbol *symbol = (Checked_Symbol *)Arena__allocate(check_arena, kind_size);
     symbol->kind = kind;
     symbol->location = location;
     symbol->name = name;
@@ -262,11 +537,11 @@ Checked_Symbol *Checked_Symbol__create_kind(Checked_Symbol_Kind kind, size_t kin
     return symbol;
 }
 
-Checked_Enum_Member_Symbol *Checked_Enum_Member_Symbol__create(Source_Location *location, String *name, Checked_Type *type) {
+Checked_Enum_Member_Symbol *Checked_Enum_Member_Symbol__create(Source_Location location, String *name, Checked_Type *type) {
     return (Checked_Enum_Member_Symbol *)Checked_Symbol__create_kind(CHECKED_SYMBOL_KIND__ENUM_MEMBER, sizeof(Checked_Enum_Member_Symbol), location, name, type);
 }
 
-Checked_Function_Symbol *Checked_Function_Symbol__create(Source_Location *location, String *symbol_name, String *function_name, Checked_Function_Type *function_type, Checked_Type *receiver_type) {
+Checked_Function_Symbol *Checked_Function_Symbol__create(Source_Location location, String *symbol_name, String *function_name, Checked_Function_Type *function_type, Checked_Type *receiver_type) {
     Checked_Function_Symbol *symbol = (Checked_Function_Symbol *)Checked_Symbol__create_kind(CHECKED_SYMBOL_KIND__FUNCTION, sizeof(Checked_Function_Symbol), location, symbol_name, (Checked_Type *)Checked_Function_Pointer_Type__create(function_type->super.location, function_type));
     symbol->function_name = function_name;
     symbol->function_type = function_type;
@@ -281,7 +556,7 @@ void pWriter__write__checked_function_symbol(Writer *writer, Checked_Function_Sy
     pWriter__write__char(writer, '(');
     Checked_Function_Parameter *parameter = function_symbol->function_type->first_parameter;
     while (parameter != NULL) {
-        if (parameter->label != NULL && !String__equals_string(parameter->label, parameter->name)) {
+        if (parameter->label != NULL && parameter->label != parameter->name) {
             pWriter__write__string(writer, parameter->label);
             pWriter__write__char(writer, ' ');
         }
@@ -300,35 +575,71 @@ void pWriter__write__checked_function_symbol(Writer *writer, Checked_Function_Sy
     }
 }
 
-Checked_Function_Parameter_Symbol *Checked_Function_Parameter_Symbol__create(Source_Location *location, String *name, Checked_Type *type) {
+Checked_Function_Parameter_Symbol *Checked_Function_Parameter_Symbol__create(Source_Location location, String *name, Checked_Type *type) {
     return (Checked_Function_Parameter_Symbol *)Checked_Symbol__create_kind(CHECKED_SYMBOL_KIND__FUNCTION_PARAMETER, sizeof(Checked_Function_Parameter_Symbol), location, name, type);
 }
 
-Checked_Type_Symbol *Checked_Type_Symbol__create(Source_Location *location, String *name, Checked_Named_Type *named_type) {
+Checked_Type_Symbol *Checked_Type_Symbol__create(Source_Location location, String *name, Checked_Named_Type *named_type) {
     Checked_Type_Symbol *symbol = (Checked_Type_Symbol *)Checked_Symbol__create_kind(CHECKED_SYMBOL_KIND__TYPE, sizeof(Checked_Type_Symbol), location, name, NULL);
     symbol->named_type = named_type;
     return symbol;
 }
 
-Checked_Variable_Symbol *Checked_Variable_Symbol__create(Source_Location *location, String *name, Checked_Type *type) {
+Checked_Variable_Symbol *Checked_Variable_Symbol__create(Source_Location location, String *name, Checked_Type *type) {
     return (Checked_Variable_Symbol *)Checked_Symbol__create_kind(CHECKED_SYMBOL_KIND__VARIABLE, sizeof(Checked_Variable_Symbol), location, name, type);
 }
 
+#define CHECKED_SYMBOLS__MAX_UNINDEXED_COUNT 8
+
 Checked_Symbols *Checked_Symbols__create(Checked_Symbols *parent) {
-    Checked_Symbols *symbols = (Checked_Symbols *)malloc(sizeof(Checked_Symbols));
+    Checked_Symbols *symbols = (Checked_Symbols *)Arena__allocate(check_arena, sizeof(Checked_Symbols));
     symbols->parent = parent;
     symbols->first_symbol = NULL;
     symbols->last_symbol = NULL;
+    symbols->symbols_count = 0;
+    symbols->symbols_table = NULL;
+    symbols->symbols_table_size = 0;
     return symbols;
 }
 
-Checked_Symbol *Checked_Symbols__find_sibling_symbol(Checked_Symbols *self, String *name) {
+static void Checked_Symbols__index_symbol(Checked_Symbols *self, Checked_Symbol *symbol) {
+    size_t index = String__interned_hash(symbol->name) & (self->symbols_table_size - 1);
+    while (self->symbols_table[index] != NULL) {
+        index = (index + 1) & (self->symbols_table_size - 1);
+    }
+    self->symbols_table[index] = symbol;
+}
+
+static void Checked_Symbols__grow_symbols_table(Checked_Symbols *self) {
+    self->symbols_table_size = self->symbols_table_size == 0 ? 4 * CHECKED_SYMBOLS__MAX_UNINDEXED_COUNT : self->symbols_table_size * 2;
+    self->symbols_table = (Checked_Symbol **)Arena__allocate(check_arena, self->symbols_table_size * sizeof(Checked_Symbol *));
+    memset(self->symbols_table, 0, self->symbols_table_size * sizeof(Checked_Symbol *));
     Checked_Symbol *symbol = self->first_symbol;
     while (symbol != NULL) {
-        if (String__equals_string(name, symbol->name)) {
+        Checked_Symbols__index_symbol(self, symbol);
+        symbol = symbol->next_symbol;
+    }
+}
+
+Checked_Symbol *Checked_Symbols__find_sibling_symbol(Checked_Symbols *self, String *name) {
+    if (self->symbols_table != NULL) {
+        size_t index = String__interned_hash(name) & (self->symbols_table_size - 1);
+        Checked_Symbol *symbol;
+        while ((symbol = self->symbols_table[index]) != NULL) {
+            if (symbol->name == name) {
+                return symbol;
+            }
+            index = (index + 1) & (self->symbols_table_size - 1);
+        }
+        return NULL;
+    }
+
+    Checked_Symbol *symbol = self->last_symbol;
+    while (symbol != NULL) {
+        if (symbol->name == name) {
             return symbol;
         }
-        symbol = symbol->next_symbol;
+        symbol = symbol->prev_symbol;
     }
     return NULL;
 }
@@ -350,238 +661,323 @@ void Checked_Symbols__append_symbol(Checked_Symbols *self, Checked_Symbol *symbo
         symbol->prev_symbol = self->last_symbol;
     }
     self->last_symbol = symbol;
+    self->symbols_count = self->symbols_count + 1;
+
+    if (self->symbols_table != NULL && self->symbols_count * 2 <= self->symbols_table_size) {
+        Checked_Symbols__index_symbol(self, symbol);
+    } else if (self->symbols_count > CHECKED_SYMBOLS__MAX_UNINDEXED_COUNT) {
+        Checked_Symbols__grow_symbols_table(self);
+    }
 }
 
 Checked_Symbol *Checked_Symbols__find_symbol(Checked_Symbols *self, String *name) {
-    Checked_Symbol *symbol = self->last_symbol;
-    while (symbol != NULL) {
-        if (String__equals_string(name, symbol->name)) {
+    while (self != NULL) {
+        Checked_Symbol *symbol = Checked_Symbols__find_sibling_symbol(self, name);
+        if (symbol != NULL) {
             return symbol;
         }
-        symbol = symbol->prev_symbol;
-    }
-    if (self->parent != NULL) {
-        return Checked_Symbols__find_symbol(self->parent, name);
+        self = self->parent;
     }
     return NULL;
 }
 
-Checked_Expression *Checked_Expression__create_kind(Checked_Expression_Kind kind, size_t kind_size, Source_Location *location, Checked_Type *type) {
-    Checked_Expression *expression = (Checked_Expression *)malloc(kind_size);
+size_t Checked_Labels_Hash__append(size_t labels_hash, String *label) {
+    return labels_hash * 31 + (label != NULL ? String__interned_hash(label) : 1);
+}
+
+Checked_Overload_Sets *Checked_Overload_Sets__create() {
+    Checked_Overload_Sets *sets = (Checked_Overload_Sets *)Arena__allocate(check_arena, sizeof(Checked_Overload_Sets));
+    sets->table = NULL;
+    sets->table_size = 0;
+    sets->count = 0;
+    return sets;
+}
+
+static Checked_Overload_Set **Checked_Overload_Sets__find_slot(Checked_Overload_Sets *self, String *function_name) {
+    size_t index = String__interned_hash(function_name) & (self->table_size - 1);
+    while (self->table[index] != NULL && self->table[index]->function_name != function_name) {
+        index = (index + 1) & (self->table_size - 1);
+    }
+    return &self->table[index];
+}
+
+static void Checked_Overload_Sets__grow(Checked_Overload_Sets *self) {
+    Checked_Overload_Set **old_table = self->table;
+    size_t old_table_size = self->table_size;
+
+    self->table_size = old_table_size == 0 ? 16 : old_table_size * 2;
+    self->table = (Checked_Overload_Set **)Arena__allocate(check_arena, self->table_size * sizeof(Checked_Overload_Set *));
+    memset(self->table, 0, self->table_size * sizeof(Checked_Overload_Set *));
+    for (size_t index = 0; index < old_table_size; index++) {
+        if (old_table[index] != NULL) {
+            *Checked_Overload_Sets__find_slot(self, old_table[index]->function_name) = old_table[index];
+        }
+    }
+}
+
+void Checked_Overload_Sets__add(Checked_Overload_Sets *self, Checked_Function_Symbol *function_symbol) {
+    if ((self->count + 1) * 2 > self->table_size) {
+        Checked_Overload_Sets__grow(self);
+    }
+
+    Checked_Overload_Set **slot = Checked_Overload_Sets__find_slot(self, function_symbol->function_name);
+    Checked_Overload_Set *set = *slot;
+    if (set == NULL) {
+        set = (Checked_Overload_Set *)Arena__allocate(check_arena, sizeof(Checked_Overload_Set));
+        set->function_name = function_symbol->function_name;
+        set->overloads = NULL;
+        set->overloads_count = 0;
+        set->overloads_size = 0;
+        *slot = set;
+        self->count = self->count + 1;
+    }
+
+    if (set->overloads_count == set->overloads_size) {
+        Checked_Overload *old_overloads = set->overloads;
+        set->overloads_size = set->overloads_size == 0 ? 2 : set->overloads_size * 2;
+        set->overloads = (Checked_Overload *)Arena__allocate(check_arena, set->overloads_size * sizeof(Checked_Overload));
+        if (set->overloads_count > 0) {
+            memcpy(set->overloads, old_overloads, set->overloads_count * sizeof(Checked_Overload));
+        }
+    }
+
+    Checked_Overload *overload = &set->overloads[set->overloads_count];
+    overload->function_symbol = function_symbol;
+    overload->labels_hash = 0;
+    overload->receiver_labels_hash = 0;
+    Checked_Function_Parameter *parameter = function_symbol->function_type->first_parameter;
+    while (parameter != NULL) {
+        overload->labels_hash = Checked_Labels_Hash__append(overload->labels_hash, parameter->label);
+        if (parameter != function_symbol->function_type->first_parameter) {
+            overload->receiver_labels_hash = Checked_Labels_Hash__append(overload->receiver_labels_hash, parameter->label);
+        }
+        parameter = parameter->next_parameter;
+    }
+    set->overloads_count = set->overloads_count + 1;
+}
+
+Checked_Overload_Set *Checked_Overload_Sets__find(Checked_Overload_Sets *self, String *function_name) {
+    if (self->table == NULL) {
+        return NULL;
+    }
+    return *Checked_Overload_Sets__find_slot(self, function_name);
+}
+
+Checked_Expression *Checked_Expression__create_kind(Checked_Expression_Kind kind, size_t kind_size, Source_Location location, Checked_Type *type) {
+    Checked_Expression *expression = (Checked_Expression *)Arena__allocate(check_arena, kind_size);
     expression->kind = kind;
     expression->location = location;
     expression->type = type;
     return expression;
 }
 
-Checked_Binary_Expression *Checked_Binary_Expression__create_kind(Checked_Expression_Kind kind, Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
+Checked_Binary_Expression *Checked_Binary_Expression__create_kind(Checked_Expression_Kind kind, Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
     Checked_Binary_Expression *expression = (Checked_Binary_Expression *)Checked_Expression__create_kind(kind, sizeof(Checked_Binary_Expression), location, type);
     expression->left_expression = left_expression;
     expression->right_expression = right_expression;
     return expression;
 }
 
-Checked_Unary_Expression *Checked_Unary_Expression__create_kind(Checked_Expression_Kind kind, size_t kind_size, Source_Location *location, Checked_Type *type, Checked_Expression *other_expression) {
+Checked_Unary_Expression *Checked_Unary_Expression__create_kind(Checked_Expression_Kind kind, size_t kind_size, Source_Location location, Checked_Type *type, Checked_Expression *other_expression) {
     Checked_Unary_Expression *expression = (Checked_Unary_Expression *)Checked_Expression__create_kind(kind, kind_size, location, type);
     expression->other_expression = other_expression;
     return expression;
 }
 
-Checked_Add_Expression *Checked_Add_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
+Checked_Add_Expression *Checked_Add_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
     return (Checked_Add_Expression *)Checked_Binary_Expression__create_kind(CHECKED_EXPRESSION_KIND__ADD, location, type, left_expression, right_expression);
 }
 
-Checked_Address_Of_Expression *Checked_Address_Of_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *other_expression) {
+Checked_Address_Of_Expression *Checked_Address_Of_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *other_expression) {
     return (Checked_Address_Of_Expression *)Checked_Unary_Expression__create_kind(CHECKED_EXPRESSION_KIND__ADDRESS_OF, sizeof(Checked_Address_Of_Expression), location, type, other_expression);
 }
 
-Checked_Array_Access_Expression *Checked_Array_Access_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *array_expression, Checked_Expression *index_expression) {
+Checked_Array_Access_Expression *Checked_Array_Access_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *array_expression, Checked_Expression *index_expression) {
     Checked_Array_Access_Expression *expression = (Checked_Array_Access_Expression *)Checked_Expression__create_kind(CHECKED_EXPRESSION_KIND__ARRAY_ACCESS, sizeof(Checked_Array_Access_Expression), location, type);
     expression->array_expression = array_expression;
     expression->index_expression = index_expression;
     return expression;
 }
 
-Checked_Bool_Expression *Checked_Bool_Expression__create(Source_Location *location, Checked_Type *type, bool value) {
+Checked_Bool_Expression *Checked_Bool_Expression__create(Source_Location location, Checked_Type *type, bool value) {
     Checked_Bool_Expression *expression = (Checked_Bool_Expression *)Checked_Expression__create_kind(CHECKED_EXPRESSION_KIND__BOOL, sizeof(Checked_Bool_Expression), location, type);
     expression->value = value;
     return expression;
 }
 
 Checked_Call_Argument *Checked_Call_Argument__create(Checked_Expression *expression) {
-    Checked_Call_Argument *argument = (Checked_Call_Argument *)malloc(sizeof(Checked_Call_Argument));
+    Checked_Call_Argument *argument = (Checked_Call_Argument *)Arena__allocate(check_arena, sizeof(Checked_Call_Argument));
     argument->expression = expression;
     argument->next_argument = NULL;
     return argument;
 }
 
-Checked_Call_Expression *Checked_Call_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *callee_expression, Checked_Call_Argument *first_argument) {
+Checked_Call_Expression *Checked_Call_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *callee_expression, Checked_Call_Argument *first_argument) {
     Checked_Call_Expression *expression = (Checked_Call_Expression *)Checked_Expression__create_kind(CHECKED_EXPRESSION_KIND__CALL, sizeof(Checked_Call_Expression), location, type);
     expression->callee_expression = callee_expression;
     expression->first_argument = first_argument;
     return expression;
 }
 
-Checked_Cast_Expression *Checked_Cast_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *other_expression) {
+Checked_Cast_Expression *Checked_Cast_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *other_expression) {
     Checked_Cast_Expression *expression = (Checked_Cast_Expression *)Checked_Expression__create_kind(CHECKED_EXPRESSION_KIND__CAST, sizeof(Checked_Cast_Expression), location, type);
     expression->other_expression = other_expression;
     return expression;
 }
 
-Checked_Character_Expression *Checked_Character_Expression__create(Source_Location *location, Checked_Type *type, char value) {
+Checked_Character_Expression *Checked_Character_Expression__create(Source_Location location, Checked_Type *type, char value) {
     Checked_Character_Expression *expression = (Checked_Character_Expression *)Checked_Expression__create_kind(CHECKED_EXPRESSION_KIND__CHARACTER, sizeof(Checked_Character_Expression), location, type);
     expression->value = value;
     return expression;
 }
 
-Checked_Dereference_Expression *Checked_Dereference_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *other_expression) {
+Checked_Dereference_Expression *Checked_Dereference_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *other_expression) {
     return (Checked_Dereference_Expression *)Checked_Unary_Expression__create_kind(CHECKED_EXPRESSION_KIND__DEREFERENCE, sizeof(Checked_Dereference_Expression), location, type, other_expression);
 }
 
-Checked_Divide_Expression *Checked_Divide_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
+Checked_Divide_Expression *Checked_Divide_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
     return (Checked_Divide_Expression *)Checked_Binary_Expression__create_kind(CHECKED_EXPRESSION_KIND__DIVIDE, location, type, left_expression, right_expression);
 }
 
-Checked_Equals_Expression *Checked_Equals_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
+Checked_Equals_Expression *Checked_Equals_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
     return (Checked_Equals_Expression *)Checked_Binary_Expression__create_kind(CHECKED_EXPRESSION_KIND__EQUALS, location, type, left_expression, right_expression);
 }
 
-Checked_Greater_Expression *Checked_Greater_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
+Checked_Greater_Expression *Checked_Greater_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
     return (Checked_Greater_Expression *)Checked_Binary_Expression__create_kind(CHECKED_EXPRESSION_KIND__GREATER, location, type, left_expression, right_expression);
 }
 
-Checked_Greater_Or_Equals_Expression *Checked_Greater_Or_Equals_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
+Checked_Greater_Or_Equals_Expression *Checked_Greater_Or_Equals_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
     return (Checked_Greater_Or_Equals_Expression *)Checked_Binary_Expression__create_kind(CHECKED_EXPRESSION_KIND__GREATER_OR_EQUALS, location, type, left_expression, right_expression);
 }
 
-Checked_Group_Expression *Checked_Group_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *other_expression) {
+Checked_Group_Expression *Checked_Group_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *other_expression) {
     Checked_Group_Expression *expression = (Checked_Group_Expression *)Checked_Expression__create_kind(CHECKED_EXPRESSION_KIND__GROUP, sizeof(Checked_Group_Expression), location, type);
     expression->other_expression = other_expression;
     return expression;
 }
 
-Checked_Integer_Expression *Checked_Integer_Expression__create(Source_Location *location, Checked_Type *type, uint64_t value) {
+Checked_Integer_Expression *Checked_Integer_Expression__create(Source_Location location, Checked_Type *type, uint64_t value) {
     Checked_Integer_Expression *expression = (Checked_Integer_Expression *)Checked_Expression__create_kind(CHECKED_EXPRESSION_KIND__INTEGER, sizeof(Checked_Integer_Expression), location, type);
     expression->value = value;
     return expression;
 }
 
-Checked_Less_Expression *Checked_Less_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
+Checked_Less_Expression *Checked_Less_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
     return (Checked_Less_Expression *)Checked_Binary_Expression__create_kind(CHECKED_EXPRESSION_KIND__LESS, location, type, left_expression, right_expression);
 }
 
-Checked_Less_Or_Equals_Expression *Checked_Less_Or_Equals_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
+Checked_Less_Or_Equals_Expression *Checked_Less_Or_Equals_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
     return (Checked_Less_Or_Equals_Expression *)Checked_Binary_Expression__create_kind(CHECKED_EXPRESSION_KIND__LESS_OR_EQUALS, location, type, left_expression, right_expression);
 }
 
-Checked_Logic_And_Expression *Checked_Logic_And_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
+Checked_Logic_And_Expression *Checked_Logic_And_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
     return (Checked_Logic_And_Expression *)Checked_Binary_Expression__create_kind(CHECKED_EXPRESSION_KIND__LOGIC_AND, location, type, left_expression, right_expression);
 }
 
-Checked_Logic_Or_Expression *Checked_Logic_Or_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
+Checked_Logic_Or_Expression *Checked_Logic_Or_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
     return (Checked_Logic_Or_Expression *)Checked_Binary_Expression__create_kind(CHECKED_EXPRESSION_KIND__LOGIC_OR, location, type, left_expression, right_expression);
 }
 
 Checked_Make_Struct_Argument *Checked_Make_Struct_Argument__create(Checked_Struct_Member *struct_member, Checked_Expression *expression) {
-    Checked_Make_Struct_Argument *argument = (Checked_Make_Struct_Argument *)malloc(sizeof(Checked_Make_Struct_Argument));
+    Checked_Make_Struct_Argument *argument = (Checked_Make_Struct_Argument *)Arena__allocate(check_arena, sizeof(Checked_Make_Struct_Argument));
     argument->struct_member = struct_member;
     argument->expression = expression;
     argument->next_argument = NULL;
     return argument;
 }
 
-Checked_Make_Struct_Expression *Checked_Make_Struct_Expression__create(Source_Location *location, Checked_Type *type, Checked_Struct_Type *struct_type, Checked_Make_Struct_Argument *first_argument) {
+Checked_Make_Struct_Expression *Checked_Make_Struct_Expression__create(Source_Location location, Checked_Type *type, Checked_Struct_Type *struct_type, Checked_Make_Struct_Argument *first_argument) {
     Checked_Make_Struct_Expression *expression = (Checked_Make_Struct_Expression *)Checked_Expression__create_kind(CHECKED_EXPRESSION_KIND__MAKE_STRUCT, sizeof(Checked_Make_Struct_Expression), location, type);
     expression->struct_type = struct_type;
     expression->first_argument = first_argument;
     return expression;
 }
 
-Checked_Member_Access_Expression *Checked_Member_Access_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *object_expression, Checked_Struct_Member *member) {
+Checked_Member_Access_Expression *Checked_Member_Access_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *object_expression, Checked_Struct_Member *member) {
     Checked_Member_Access_Expression *expression = (Checked_Member_Access_Expression *)Checked_Expression__create_kind(CHECKED_EXPRESSION_KIND__MEMBER_ACCESS, sizeof(Checked_Member_Access_Expression), location, type);
     expression->object_expression = object_expression;
     expression->member = member;
     return expression;
 }
 
-Checked_Minus_Expression *Checked_Minus_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *other_expression) {
+Checked_Minus_Expression *Checked_Minus_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *other_expression) {
     return (Checked_Minus_Expression *)Checked_Unary_Expression__create_kind(CHECKED_EXPRESSION_KIND__MINUS, sizeof(Checked_Minus_Expression), location, type, other_expression);
 }
 
-Checked_Modulo_Expression *Checked_Modulo_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
+Checked_Modulo_Expression *Checked_Modulo_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
     return (Checked_Modulo_Expression *)Checked_Binary_Expression__create_kind(CHECKED_EXPRESSION_KIND__MODULO, location, type, left_expression, right_expression);
 }
 
-Checked_Multiply_Expression *Checked_Multiply_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
+Checked_Multiply_Expression *Checked_Multiply_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
     return (Checked_Multiply_Expression *)Checked_Binary_Expression__create_kind(CHECKED_EXPRESSION_KIND__MULTIPLY, location, type, left_expression, right_expression);
 }
 
-Checked_Not_Expression *Checked_Not_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *other_expression) {
+Checked_Not_Expression *Checked_Not_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *other_expression) {
     return (Checked_Not_Expression *)Checked_Unary_Expression__create_kind(CHECKED_EXPRESSION_KIND__NOT, sizeof(Checked_Not_Expression), location, type, other_expression);
 }
 
-Checked_Not_Equals_Expression *Checked_Not_Equals_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
+Checked_Not_Equals_Expression *Checked_Not_Equals_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
     return (Checked_Not_Equals_Expression *)Checked_Binary_Expression__create_kind(CHECKED_EXPRESSION_KIND__NOT_EQUALS, location, type, left_expression, right_expression);
 }
 
-Checked_Null_Expression *Checked_Null_Expression__create(Source_Location *location, Checked_Type *type) {
+Checked_Null_Expression *Checked_Null_Expression__create(Source_Location location, Checked_Type *type) {
     return (Checked_Null_Expression *)Checked_Expression__create_kind(CHECKED_EXPRESSION_KIND__NULL, sizeof(Checked_Null_Expression), location, type);
 }
 
-Checked_Sizeof_Expression *Checked_Sizeof_Expression__create(Source_Location *location, Checked_Type *type, Checked_Type *sized_type) {
+Checked_Sizeof_Expression *Checked_Sizeof_Expression__create(Source_Location location, Checked_Type *type, Checked_Type *sized_type) {
     Checked_Sizeof_Expression *expression = (Checked_Sizeof_Expression *)Checked_Expression__create_kind(CHECKED_EXPRESSION_KIND__SIZEOF, sizeof(Checked_Sizeof_Expression), location, type);
     expression->sized_type = sized_type;
     return expression;
 }
 
-Checked_String_Expression *Checked_String_Expression__create(Source_Location *location, Checked_Type *type, String *value) {
+Checked_String_Expression *Checked_String_Expression__create(Source_Location location, Checked_Type *type, String *value) {
     Checked_String_Expression *expression = (Checked_String_Expression *)Checked_Expression__create_kind(CHECKED_EXPRESSION_KIND__STRING, sizeof(Checked_String_Expression), location, type);
     expression->value = value;
     return expression;
 }
 
-Checked_Substract_Expression *Checked_Substract_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
+Checked_Substract_Expression *Checked_Substract_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression) {
     return (Checked_Substract_Expression *)Checked_Binary_Expression__create_kind(CHECKED_EXPRESSION_KIND__SUBSTRACT, location, type, left_expression, right_expression);
 }
 
-Checked_Symbol_Expression *Checked_Symbol_Expression__create(Source_Location *location, Checked_Type *type, Checked_Symbol *symbol) {
+Checked_Symbol_Expression *Checked_Symbol_Expression__create(Source_Location location, Checked_Type *type, Checked_Symbol *symbol) {
     Checked_Symbol_Expression *expression = (Checked_Symbol_Expression *)Checked_Expression__create_kind(CHECKED_EXPRESSION_KIND__SYMBOL, sizeof(Checked_Symbol_Expression), location, type);
     expression->symbol = symbol;
     return expression;
 }
 
-Checked_Statement *Checked_Statement__create_kind(Checked_Statement_Kind kind, size_t kind_size, Source_Location *location) {
-    Checked_Statement *statement = (Checked_Statement *)malloc(kind_size);
+Checked_Statement *Checked_Statement__create_kind(Checked_Statement_Kind kind, size_t kind_size, Source_Location location) {
+    Checked_Statement *statement = (Checked_Statement *)Arena__allocate(check_arena, kind_size);
     statement->kind = kind;
     statement->location = location;
-    statement->next_statement = NULL;
     return statement;
 }
 
-Checked_Assignment_Statement *Checked_Assignment_Statement__create(Source_Location *location, Checked_Expression *object_expression, Checked_Expression *value_expression) {
+Checked_Assignment_Statement *Checked_Assignment_Statement__create(Source_Location location, Checked_Expression *object_expression, Checked_Expression *value_expression) {
     Checked_Assignment_Statement *statement = (Checked_Assignment_Statement *)Checked_Statement__create_kind(CHECKED_STATEMENT_KIND__ASSIGNMENT, sizeof(Checked_Assignment_Statement), location);
     statement->object_expression = object_expression;
     statement->value_expression = value_expression;
     return statement;
 }
 
-Checked_Block_Statement *Checked_Block_Statement__create(Source_Location *location, Checked_Statements *statements) {
+Checked_Block_Statement *Checked_Block_Statement__create(Source_Location location, Checked_Statements *statements) {
     Checked_Block_Statement *statement = (Checked_Block_Statement *)Checked_Statement__create_kind(CHECKED_STATEMENT_KIND__BLOCK, sizeof(Checked_Block_Statement), location);
     statement->statements = statements;
     return statement;
 }
 
-Checked_Break_Statement *Checked_Break_Statement__create(Source_Location *location) {
+Checked_Break_Statement *Checked_Break_Statement__create(Source_Location location) {
     return (Checked_Break_Statement *)Checked_Statement__create_kind(CHECKED_STATEMENT_KIND__BREAK, sizeof(Checked_Break_Statement), location);
 }
 
-Checked_Expression_Statement *Checked_Expression_Statement__create(Source_Location *location, Checked_Expression *expression) {
+Checked_Expression_Statement *Checked_Expression_Statement__create(Source_Location location, Checked_Expression *expression) {
     Checked_Expression_Statement *statement = (Checked_Expression_Statement *)Checked_Statement__create_kind(CHECKED_STATEMENT_KIND__EXPRESSION, sizeof(Checked_Expression_Statement), location);
     statement->expression = expression;
     return statement;
 }
 
-Checked_If_Statement *Checked_If_Statement__create(Source_Location *location, Checked_Expression *condition_expression, Checked_Statement *true_statement, Checked_Statement *false_statement) {
+Checked_If_Statement *Checked_If_Statement__create(Source_Location location, Checked_Expression *condition_expression, Checked_Statement *true_statement, Checked_Statement *false_statement) {
     Checked_If_Statement *statement = (Checked_If_Statement *)Checked_Statement__create_kind(CHECKED_STATEMENT_KIND__IF, sizeof(Checked_If_Statement), location);
     statement->condition_expression = condition_expression;
     statement->true_statement = true_statement;
@@ -589,19 +985,19 @@ Checked_If_Statement *Checked_If_Statement__create(Source_Location *location, Ch
     return statement;
 }
 
-Checked_Loop_Statement *Checked_Loop_Statement__create(Source_Location *location, Checked_Statement *body_statement) {
+Checked_Loop_Statement *Checked_Loop_Statement__create(Source_Location location, Checked_Statement *body_statement) {
     Checked_Loop_Statement *statement = (Checked_Loop_Statement *)Checked_Statement__create_kind(CHECKED_STATEMENT_KIND__LOOP, sizeof(Checked_Loop_Statement), location);
     statement->body_statement = body_statement;
     return statement;
 }
 
-Checked_Return_Statement *Checked_Return_Statement__create(Source_Location *location, Checked_Expression *expression) {
+Checked_Return_Statement *Checked_Return_Statement__create(Source_Location location, Checked_Expression *expression) {
     Checked_Return_Statement *statement = (Checked_Return_Statement *)Checked_Statement__create_kind(CHECKED_STATEMENT_KIND__RETURN, sizeof(Checked_Return_Statement), location);
     statement->expression = expression;
     return statement;
 }
 
-Checked_Variable_Statement *Checked_Variable_Statement__create(Source_Location *location, Checked_Variable_Symbol *variable, Checked_Expression *expression, bool is_external) {
+Checked_Variable_Statement *Checked_Variable_Statement__create(Source_Location location, Checked_Variable_Symbol *variable, Checked_Expression *expression, bool is_external) {
     Checked_Variable_Statement *statement = (Checked_Variable_Statement *)Checked_Statement__create_kind(CHECKED_STATEMENT_KIND__VARIABLE, sizeof(Checked_Variable_Statement), location);
     statement->variable = variable;
     statement->expression = expression;
@@ -609,7 +1005,7 @@ Checked_Variable_Statement *Checked_Variable_Statement__create(Source_Location *
     return statement;
 }
 
-Checked_While_Statement *Checked_While_Statement__create(Source_Location *location, Checked_Expression *condition_expression, Checked_Statement *body_statement) {
+Checked_While_Statement *Checked_While_Statement__create(Source_Location location, Checked_Expression *condition_expression, Checked_Statement *body_statement) {
     Checked_While_Statement *statement = (Checked_While_Statement *)Checked_Statement__create_kind(CHECKED_STATEMENT_KIND__WHILE, sizeof(Checked_While_Statement), location);
     statement->condition_expression = condition_expression;
     statement->body_statement = body_statement;
@@ -617,17 +1013,23 @@ Checked_While_Statement *Checked_While_Statement__create(Source_Location *locati
 }
 
 Checked_Statements *Checked_Statements__create() {
-    Checked_Statements *statements = (Checked_Statements *)malloc(sizeof(Checked_Statements));
-    statements->first_statement = NULL;
-    statements->last_statement = NULL;
+    Checked_Statements *statements = (Checked_Statements *)Arena__allocate(check_arena, sizeof(Checked_Statements));
+    statements->statements = NULL;
+    statements->statements_count = 0;
+    statements->statements_size = 0;
     return statements;
 }
 
 void Checked_Statements__append(Checked_Statements *self, Checked_Statement *statement) {
-    if (self->first_statement == NULL) {
-        self->first_statement = statement;
-    } else {
-        self->last_statement->next_statement = statement;
+    if (self->statements_count == self->statements_size) {
+        uint32_t statements_size = self->statements_size == 0 ? 8 : self->statements_size * 2;
+        Checked_Statement **statements = (Checked_Statement **)Arena__allocate(check_arena, statements_size * sizeof(Checked_Statement *));
+        if (self->statements_count > 0) {
+            memcpy(statements, self->statements, self->statements_count * sizeof(Checked_Statement *));
+        }
+        self->statements = statements;
+        self->statements_size = statements_size;
     }
-    self->last_statement = statement;
+    self->statements[self->statements_count] = statement;
+    self->statements_count = self->statements_count + 1;
 }
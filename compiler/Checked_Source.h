@@ -35,11 +35,12 @@ typedef enum Checked_Type_Kind {
 
 typedef struct Checked_Type {
     Checked_Type_Kind kind;
-    Source_Location *location;
-    struct Checked_Type *next_type;
+    Source_Location location;
+    /* Structurally equal types share the same canonical type */
+    struct Checked_Type *canonical_type;
 } Checked_Type;
 
-Checked_Type *Checked_Type__create_kind(Checked_Type_Kind kind, size_t kind_size, Source_Location *location);
+Checked_Type *Checked_Type__create_kind(Checked_Type_Kind kind, size_t kind_size, Source_Location location);
 
 bool Checked_Type__is_numeric_type(Checked_Type *self);
 
@@ -78,7 +79,7 @@ typedef enum Checked_Expression_Kind {
 
 typedef struct Checked_Expression {
     Checked_Expression_Kind kind;
-    Source_Location *location;
+    Source_Location location;
     Checked_Type *type;
 } Checked_Expression;
 
@@ -89,30 +90,32 @@ typedef struct Checked_Array_Type {
     Checked_Expression *size_expression;
 } Checked_Array_Type;
 
-Checked_Array_Type *Checked_Array_Type__create(Source_Location *location, Checked_Type *item_type, bool is_checked, Checked_Expression *size_expression);
+Checked_Array_Type *Checked_Array_Type__create(Source_Location location, Checked_Type *item_type, bool is_checked, Checked_Expression *size_expression);
 
 typedef struct Checked_Named_Type {
     Checked_Type super;
     String *name;
+    /* Functions having this type (or a pointer/array of it) as receiver */
+    struct Checked_Overload_Sets *methods;
 } Checked_Named_Type;
 
-Checked_Named_Type *Checked_Named_Type__create_kind(Checked_Type_Kind kind, size_t kind_size, Source_Location *location, String *name);
+Checked_Named_Type *Checked_Named_Type__create_kind(Checked_Type_Kind kind, size_t kind_size, Source_Location location, String *name);
 
 typedef struct Checked_External_Type {
     Checked_Named_Type super;
 } Checked_External_Type;
 
-Checked_External_Type *Checked_External_Type__create(Source_Location *location, String *name);
+Checked_External_Type *Checked_External_Type__create(Source_Location location, String *name);
 
 typedef struct Checked_Function_Parameter {
-    Source_Location *location;
+    Source_Location location;
     String *label;
     String *name;
     Checked_Type *type;
     struct Checked_Function_Parameter *next_parameter;
 } Checked_Function_Parameter;
 
-Checked_Function_Parameter *Checked_Function_Parameter__create(Source_Location *location, String *label, String *name, Checked_Type *type);
+Checked_Function_Parameter *Checked_Function_Parameter__create(Source_Location location, String *label, String *name, Checked_Type *type);
 
 typedef struct Checked_Function_Type {
     Checked_Type super;
@@ -120,7 +123,8 @@ typedef struct Checked_Function_Type {
     Checked_Function_Parameter *first_parameter;
 } Checked_Function_Type;
 
-Checked_Function_Type *Checked_Function_Type__create(Source_Location *location, Checked_Function_Parameter *first_parameter, Checked_Type *return_type);
+/* The parameters must not change after the function type is created */
+Checked_Function_Type *Checked_Function_Type__create(Source_Location location, Checked_Function_Parameter *first_parameter, Checked_Type *return_type);
 
 bool Checked_Function_Type__equals(Checked_Function_Type *self, Checked_Function_Type *other);
 
@@ -129,42 +133,55 @@ typedef struct Checked_Function_Pointer_Type {
     Checked_Function_Type *function_type;
 } Checked_Function_Pointer_Type;
 
-Checked_Function_Pointer_Type *Checked_Function_Pointer_Type__create(Source_Location *location, Checked_Function_Type *function_type);
+Checked_Function_Pointer_Type *Checked_Function_Pointer_Type__create(Source_Location location, Checked_Function_Type *function_type);
 
 typedef struct Checked_Pointer_Type {
     Checked_Type super;
     Checked_Type *other_type;
 } Checked_Pointer_Type;
 
-Checked_Pointer_Type *Checked_Pointer_Type__create(Source_Location *location, Checked_Type *other_type);
+Checked_Pointer_Type *Checked_Pointer_Type__create(Source_Location location, Checked_Type *other_type);
 
 typedef struct Checked_Struct_Member {
-    Source_Location *location;
+    Source_Location location;
     String *name;
     Checked_Type *type;
-    struct Checked_Struct_Member *next_member;
+    size_t offset;
 } Checked_Struct_Member;
 
-Checked_Struct_Member *Checked_Struct_Member__create(Source_Location *location, String *name, Checked_Type *type);
-
 typedef struct Checked_Struct_Type {
     Checked_Named_Type super;
-    Checked_Struct_Member *first_member;
+    Checked_Struct_Member *members;
+    size_t members_count;
+    size_t members_size;
+    Checked_Struct_Member **members_table;
+    size_t members_table_size;
+    /* The layout is known only when the size of every member is known */
+    bool has_layout;
+    size_t size;
+    size_t alignment;
 } Checked_Struct_Type;
 
-Checked_Struct_Type *Checked_Struct_Type__create(Source_Location *location, String *name);
+Checked_Struct_Type *Checked_Struct_Type__create(Source_Location location, String *name);
+
+/* Allocates room for all members, so that member pointers stay valid while appending */
+void Checked_Struct_Type__reserve_members(Checked_Struct_Type *self, size_t members_size);
+
+Checked_Struct_Member *Checked_Struct_Type__append_member(Checked_Struct_Type *self, Source_Location location, String *name, Checked_Type *type);
 
 Checked_Struct_Member *Checked_Struct_Type__find_member(Checked_Struct_Type *self, String *name);
 
+void Checked_Struct_Type__compute_layout(Checked_Struct_Type *self);
+
 typedef struct Checked_Trait_Method {
-    Source_Location *location;
+    Source_Location location;
     String *name;
     Checked_Function_Type *function_type;
     Checked_Struct_Member *struct_member;
     struct Checked_Trait_Method *next_method;
 } Checked_Trait_Method;
 
-Checked_Trait_Method *Checked_Trait_Method__create(Source_Location *location, String *name, Checked_Function_Type *function_type, Checked_Struct_Member *struct_member);
+Checked_Trait_Method *Checked_Trait_Method__create(Source_Location location, String *name, Checked_Function_Type *function_type, Checked_Struct_Member *struct_member);
 
 typedef struct Checked_Trait_Type {
     Checked_Named_Type super;
@@ -173,10 +190,19 @@ typedef struct Checked_Trait_Type {
     Checked_Trait_Method *first_method;
 } Checked_Trait_Type;
 
-Checked_Trait_Type *Checked_Trait_Type__create(Source_Location *location, String *name);
+Checked_Trait_Type *Checked_Trait_Type__create(Source_Location location, String *name);
 
 bool Checked_Type__equals(Checked_Type *self, Checked_Type *other);
 
+/* Hashes the type structure, consistent with Checked_Type__equals */
+size_t Checked_Type__hash(Checked_Type *self);
+
+/* Returns false if the size of the type is not known to the checker */
+bool Checked_Type__get_layout(Checked_Type *self, size_t *size, size_t *alignment);
+
+/* Returns the named type behind pointers and arrays, or NULL if there is none */
+Checked_Named_Type *Checked_Type__base_named_type(Checked_Type *self);
+
 void pWriter__write__checked_type(Writer *writer, Checked_Type *type);
 
 typedef enum Checked_Symbol_Kind {
@@ -189,20 +215,20 @@ typedef enum Checked_Symbol_Kind {
 
 typedef struct Checked_Symbol {
     Checked_Symbol_Kind kind;
-    Source_Location *location;
+    Source_Location location;
     String *name;
     Checked_Type *type;
     struct Checked_Symbol *prev_symbol;
     struct Checked_Symbol *next_symbol;
 } Checked_Symbol;
 
-Checked_Symbol *Checked_Symbol__create_kind(Checked_Symbol_Kind kind, size_t kind_size, Source_Location *location, String *name, Checked_Type *type);
+Checked_Symbol *Checked_Symbol__create_kind(Checked_Symbol_Kind kind, size_t kind_size, Source_Location location, String *name, Checked_Type *type);
 
 typedef struct Checked_Enum_Member_Symbol {
     Checked_Symbol super;
 } Checked_Enum_Member_Symbol;
 
-Checked_Enum_Member_Symbol *Checked_Enum_Member_Symbol__create(Source_Location *location, String *name, Checked_Type *type);
+Checked_Enum_Member_Symbol *Checked_Enum_Member_Symbol__create(Source_Location location, String *name, Checked_Type *type);
 
 typedef enum Checked_Statement_Kind {
     CHECKED_STATEMENT_KIND__ASSIGNMENT,
@@ -218,15 +244,16 @@ typedef enum Checked_Statement_Kind {
 
 typedef struct Checked_Statement {
     Checked_Statement_Kind kind;
-    Source_Location *location;
-    struct Checked_Statement *next_statement;
+    Source_Location location;
 } Checked_Statement;
 
-Checked_Statement *Checked_Statement__create_kind(Checked_Statement_Kind kind, size_t kind_size, Source_Location *location);
+Checked_Statement *Checked_Statement__create_kind(Checked_Statement_Kind kind, size_t kind_size, Source_Location location);
 
+/* The statements are stored contiguously, in order */
 typedef struct Checked_Statements {
-    Checked_Statement *first_statement;
-    Checked_Statement *last_statement;
+    Checked_Statement **statements;
+    uint32_t statements_count;
+    uint32_t statements_size;
 } Checked_Statements;
 
 Checked_Statements *Checked_Statements__create();
@@ -241,7 +268,7 @@ typedef struct Checked_Function_Symbol {
     Checked_Statements *checked_statements;
 } Checked_Function_Symbol;
 
-Checked_Function_Symbol *Checked_Function_Symbol__create(Source_Location *location, String *symbol_name, String *function_name, Checked_Function_Type *function_type, Checked_Type *receiver_type);
+Checked_Function_Symbol *Checked_Function_Symbol__create(Source_Location location, String *symbol_name, String *function_name, Checked_Function_Type *function_type, Checked_Type *receiver_type);
 
 void pWriter__write__checked_function_symbol(Writer *writer, Checked_Function_Symbol *function_symbol);
 
@@ -249,25 +276,29 @@ typedef struct Checked_Function_Parameter_Symbol {
     Checked_Symbol super;
 } Checked_Function_Parameter_Symbol;
 
-Checked_Function_Parameter_Symbol *Checked_Function_Parameter_Symbol__create(Source_Location *location, String *name, Checked_Type *type);
+Checked_Function_Parameter_Symbol *Checked_Function_Parameter_Symbol__create(Source_Location location, String *name, Checked_Type *type);
 
 typedef struct Checked_Type_Symbol {
     Checked_Symbol super;
     Checked_Named_Type *named_type;
 } Checked_Type_Symbol;
 
-Checked_Type_Symbol *Checked_Type_Symbol__create(Source_Location *location, String *name, Checked_Named_Type *named_type);
+Checked_Type_Symbol *Checked_Type_Symbol__create(Source_Location location, String *name, Checked_Named_Type *named_type);
 
 typedef struct Checked_Variable_Symbol {
     Checked_Symbol super;
 } Checked_Variable_Symbol;
 
-Checked_Variable_Symbol *Checked_Variable_Symbol__create(Source_Location *location, String *name, Checked_Type *type);
+Checked_Variable_Symbol *Checked_Variable_Symbol__create(Source_Location location, String *name, Checked_Type *type);
 
+/* Keeps the symbols in declaration order, and indexes them by name once there are enough of them */
 typedef struct Checked_Symbols {
     struct Checked_Symbols *parent;
     Checked_Symbol *first_symbol;
     Checked_Symbol *last_symbol;
+    size_t symbols_count;
+    Checked_Symbol **symbols_table;
+    size_t symbols_table_size;
 } Checked_Symbols;
 
 Checked_Symbols *Checked_Symbols__create(Checked_Symbols *parent);
@@ -278,7 +309,36 @@ void Checked_Symbols__append_symbol(Checked_Symbols *self, Checked_Symbol *symbo
 
 Checked_Symbol *Checked_Symbols__find_symbol(Checked_Symbols *self, String *name);
 
-Checked_Expression *Checked_Expression__create_kind(Checked_Expression_Kind kind, size_t kind_size, Source_Location *location, Checked_Type *type);
+size_t Checked_Labels_Hash__append(size_t labels_hash, String *label);
+
+typedef struct Checked_Overload {
+    Checked_Function_Symbol *function_symbol;
+    /* Hash of the parameter labels, with and without the receiver parameter */
+    size_t labels_hash;
+    size_t receiver_labels_hash;
+} Checked_Overload;
+
+/* Functions sharing the same name, in declaration order */
+typedef struct Checked_Overload_Set {
+    String *function_name;
+    Checked_Overload *overloads;
+    size_t overloads_count;
+    size_t overloads_size;
+} Checked_Overload_Set;
+
+typedef struct Checked_Overload_Sets {
+    Checked_Overload_Set **table;
+    size_t table_size;
+    size_t count;
+} Checked_Overload_Sets;
+
+Checked_Overload_Sets *Checked_Overload_Sets__create();
+
+void Checked_Overload_Sets__add(Checked_Overload_Sets *self, Checked_Function_Symbol *function_symbol);
+
+Checked_Overload_Set *Checked_Overload_Sets__find(Checked_Overload_Sets *self, String *function_name);
+
+Checked_Expression *Checked_Expression__create_kind(Checked_Expression_Kind kind, size_t kind_size, Source_Location location, Checked_Type *type);
 
 typedef struct Checked_Binary_Expression {
     Checked_Expression super;
@@ -286,26 +346,26 @@ typedef struct Checked_Binary_Expression {
     Checked_Expression *right_expression;
 } Checked_Binary_Expression;
 
-Checked_Binary_Expression *Checked_Binary_Expression__create_kind(Checked_Expression_Kind kind, Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
+Checked_Binary_Expression *Checked_Binary_Expression__create_kind(Checked_Expression_Kind kind, Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
 
 typedef struct Checked_Unary_Expression {
     Checked_Expression super;
     Checked_Expression *other_expression;
 } Checked_Unary_Expression;
 
-Checked_Unary_Expression *Checked_Unary_Expression__create_kind(Checked_Expression_Kind kind, size_t kind_size, Source_Location *location, Checked_Type *type, Checked_Expression *other_expression);
+Checked_Unary_Expression *Checked_Unary_Expression__create_kind(Checked_Expression_Kind kind, size_t kind_size, Source_Location location, Checked_Type *type, Checked_Expression *other_expression);
 
 typedef struct Checked_Add_Expression {
     Checked_Binary_Expression super;
 } Checked_Add_Expression;
 
-Checked_Add_Expression *Checked_Add_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
+Checked_Add_Expression *Checked_Add_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
 
 typedef struct Checked_Address_Of_Expression {
     Checked_Unary_Expression super;
 } Checked_Address_Of_Expression;
 
-Checked_Address_Of_Expression *Checked_Address_Of_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *other_expression);
+Checked_Address_Of_Expression *Checked_Address_Of_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *other_expression);
 
 typedef struct Checked_Array_Access_Expression {
     Checked_Expression super;
@@ -313,14 +373,14 @@ typedef struct Checked_Array_Access_Expression {
     Checked_Expression *index_expression;
 } Checked_Array_Access_Expression;
 
-Checked_Array_Access_Expression *Checked_Array_Access_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *array_expression, Checked_Expression *index_expression);
+Checked_Array_Access_Expression *Checked_Array_Access_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *array_expression, Checked_Expression *index_expression);
 
 typedef struct Checked_Bool_Expression {
     Checked_Expression super;
     bool value;
 } Checked_Bool_Expression;
 
-Checked_Bool_Expression *Checked_Bool_Expression__create(Source_Location *location, Checked_Type *type, bool value);
+Checked_Bool_Expression *Checked_Bool_Expression__create(Source_Location location, Checked_Type *type, bool value);
 
 typedef struct Checked_Call_Argument {
     Checked_Expression *expression;
@@ -335,89 +395,89 @@ typedef struct Checked_Call_Expression {
     Checked_Call_Argument *first_argument;
 } Checked_Call_Expression;
 
-Checked_Call_Expression *Checked_Call_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *callee_expression, Checked_Call_Argument *first_argument);
+Checked_Call_Expression *Checked_Call_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *callee_expression, Checked_Call_Argument *first_argument);
 
 typedef struct Checked_Cast_Expression {
     Checked_Expression super;
     Checked_Expression *other_expression;
 } Checked_Cast_Expression;
 
-Checked_Cast_Expression *Checked_Cast_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *other_expression);
+Checked_Cast_Expression *Checked_Cast_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *other_expression);
 
 typedef struct Checked_Character_Expression {
     Checked_Expression super;
     char value;
 } Checked_Character_Expression;
 
-Checked_Character_Expression *Checked_Character_Expression__create(Source_Location *location, Checked_Type *type, char value);
+Checked_Character_Expression *Checked_Character_Expression__create(Source_Location location, Checked_Type *type, char value);
 
 typedef struct Checked_Dereference_Expression {
     Checked_Unary_Expression super;
 } Checked_Dereference_Expression;
 
-Checked_Dereference_Expression *Checked_Dereference_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *other_expression);
+Checked_Dereference_Expression *Checked_Dereference_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *other_expression);
 
 typedef struct Checked_Divide_Expression {
     Checked_Binary_Expression super;
 } Checked_Divide_Expression;
 
-Checked_Divide_Expression *Checked_Divide_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
+Checked_Divide_Expression *Checked_Divide_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
 
 typedef struct Checked_Equals_Expression {
     Checked_Binary_Expression super;
 } Checked_Equals_Expression;
 
-Checked_Equals_Expression *Checked_Equals_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
+Checked_Equals_Expression *Checked_Equals_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
 
 typedef struct Checked_Greater_Expression {
     Checked_Binary_Expression super;
 } Checked_Greater_Expression;
 
-Checked_Greater_Expression *Checked_Greater_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
+Checked_Greater_Expression *Checked_Greater_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
 
 typedef struct Checked_Greater_Or_Equals_Expression {
     Checked_Binary_Expression super;
 } Checked_Greater_Or_Equals_Expression;
 
-Checked_Greater_Or_Equals_Expression *Checked_Greater_Or_Equals_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
+Checked_Greater_Or_Equals_Expression *Checked_Greater_Or_Equals_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
 
 typedef struct Checked_Group_Expression {
     Checked_Expression super;
     Checked_Expression *other_expression;
 } Checked_Group_Expression;
 
-Checked_Group_Expression *Checked_Group_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *other_expression);
+Checked_Group_Expression *Checked_Group_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *other_expression);
 
 typedef struct Checked_Integer_Expression {
     Checked_Expression super;
     uint64_t value;
 } Checked_Integer_Expression;
 
-Checked_Integer_Expression *Checked_Integer_Expression__create(Source_Location *location, Checked_Type *type, uint64_t value);
+Checked_Integer_Expression *Checked_Integer_Expression__create(Source_Location location, Checked_Type *type, uint64_t value);
 
 typedef struct Checked_Less_Expression {
     Checked_Binary_Expression super;
 } Checked_Less_Expression;
 
-Checked_Less_Expression *Checked_Less_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
+Checked_Less_Expression *Checked_Less_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
 
 typedef struct Checked_Less_Or_Equals_Expression {
     Checked_Binary_Expression super;
 } Checked_Less_Or_Equals_Expression;
 
-Checked_Less_Or_Equals_Expression *Checked_Less_Or_Equals_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
+Checked_Less_Or_Equals_Expression *Checked_Less_Or_Equals_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
 
 typedef struct Checked_Logic_And_Expression {
     Checked_Binary_Expression super;
 } Checked_Logic_And_Expression;
 
-Checked_Logic_And_Expression *Checked_Logic_And_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
+Checked_Logic_And_Expression *Checked_Logic_And_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
 
 typedef struct Checked_Logic_Or_Expression {
     Checked_Binary_Expression super;
 } Checked_Logic_Or_Expression;
 
-Checked_Logic_Or_Expression *Checked_Logic_Or_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
+Checked_Logic_Or_Expression *Checked_Logic_Or_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
 
 typedef struct Checked_Make_Struct_Argument {
     Checked_Struct_Member *struct_member;
@@ -433,7 +493,7 @@ typedef struct Checked_Make_Struct_Expression {
     Checked_Make_Struct_Argument *first_argument;
 } Checked_Make_Struct_Expression;
 
-Checked_Make_Struct_Expression *Checked_Make_Struct_Expression__create(Source_Location *location, Checked_Type *type, Checked_Struct_Type *struct_type, Checked_Make_Struct_Argument *first_argument);
+Checked_Make_Struct_Expression *Checked_Make_Struct_Expression__create(Source_Location location, Checked_Type *type, Checked_Struct_Type *struct_type, Checked_Make_Struct_Argument *first_argument);
 
 typedef struct Checked_Member_Access_Expression {
     Checked_Expression super;
@@ -441,70 +501,70 @@ typedef struct Checked_Member_Access_Expression {
     Checked_Struct_Member *member;
 } Checked_Member_Access_Expression;
 
-Checked_Member_Access_Expression *Checked_Member_Access_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *object_expression, Checked_Struct_Member *member);
+Checked_Member_Access_Expression *Checked_Member_Access_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *object_expression, Checked_Struct_Member *member);
 
 typedef struct Checked_Minus_Expression {
     Checked_Unary_Expression super;
 } Checked_Minus_Expression;
 
-Checked_Minus_Expression *Checked_Minus_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *other_expression);
+Checked_Minus_Expression *Checked_Minus_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *other_expression);
 
 typedef struct Checked_Modulo_Expression {
     Checked_Binary_Expression super;
 } Checked_Modulo_Expression;
 
-Checked_Modulo_Expression *Checked_Modulo_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
+Checked_Modulo_Expression *Checked_Modulo_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
 
 typedef struct Checked_Multiply_Expression {
     Checked_Binary_Expression super;
 } Checked_Multiply_Expression;
 
-Checked_Multiply_Expression *Checked_Multiply_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
+Checked_Multiply_Expression *Checked_Multiply_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
 
 typedef struct Checked_Not_Expression {
     Checked_Unary_Expression super;
 } Checked_Not_Expression;
 
-Checked_Not_Expression *Checked_Not_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *other_expression);
+Checked_Not_Expression *Checked_Not_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *other_expression);
 
 typedef struct Checked_Not_Equals_Expression {
     Checked_Binary_Expression super;
 } Checked_Not_Equals_Expression;
 
-Checked_Not_Equals_Expression *Checked_Not_Equals_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
+Checked_Not_Equals_Expression *Checked_Not_Equals_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
 
 typedef struct Checked_Null_Expression {
     Checked_Expression super;
 } Checked_Null_Expression;
 
-Checked_Null_Expression *Checked_Null_Expression__create(Source_Location *location, Checked_Type *type);
+Checked_Null_Expression *Checked_Null_Expression__create(Source_Location location, Checked_Type *type);
 
 typedef struct Checked_Sizeof_Expression {
     Checked_Expression super;
     Checked_Type *sized_type;
 } Checked_Sizeof_Expression;
 
-Checked_Sizeof_Expression *Checked_Sizeof_Expression__create(Source_Location *location, Checked_Type *type, Checked_Type *sized_type);
+Checked_Sizeof_Expression *Checked_Sizeof_Expression__create(Source_Location location, Checked_Type *type, Checked_Type *sized_type);
 
 typedef struct Checked_String_Expression {
     Checked_Expression super;
     String *value;
 } Checked_String_Expression;
 
-Checked_String_Expression *Checked_String_Expression__create(Source_Location *location, Checked_Type *type, String *value);
+Checked_String_Expression *Checked_String_Expression__create(Source_Location location, Checked_Type *type, String *value);
 
 typedef struct Checked_Substract_Expression {
     Checked_Binary_Expression super;
 } Checked_Substract_Expression;
 
-Checked_Substract_Expression *Checked_Substract_Expression__create(Source_Location *location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
+Checked_Substract_Expression *Checked_Substract_Expression__create(Source_Location location, Checked_Type *type, Checked_Expression *left_expression, Checked_Expression *right_expression);
 
 typedef struct Checked_Symbol_Expression {
     Checked_Expression super;
     Checked_Symbol *symbol;
 } Checked_Symbol_Expression;
 
-Checked_Symbol_Expression *Checked_Symbol_Expression__create(Source_Location *location, Checked_Type *type, Checked_Symbol *symbol);
+Checked_Symbol_Expression *Checked_Symbol_Expression__create(Source_Location location, Checked_Type *type, Checked_Symbol *symbol);
 
 typedef struct Checked_Assignment_Statement {
     Checked_Statement super;
@@ -512,27 +572,27 @@ typedef struct Checked_Assignment_Statement {
     Checked_Expression *value_expression;
 } Checked_Assignment_Statement;
 
-Checked_Assignment_Statement *Checked_Assignment_Statement__create(Source_Location *location, Checked_Expression *object_expression, Checked_Expression *value_expression);
+Checked_Assignment_Statement *Checked_Assignment_Statement__create(Source_Location location, Checked_Expression *object_expression, Checked_Expression *value_expression);
 
 typedef struct Checked_Block_Statement {
     Checked_Statement super;
     Checked_Statements *statements;
 } Checked_Block_Statement;
 
-Checked_Block_Statement *Checked_Block_Statement__create(Source_Location *location, Checked_Statements *statements);
+Checked_Block_Statement *Checked_Block_Statement__create(Source_Location location, Checked_Statements *statements);
 
 typedef struct Checked_Break_Statement {
     Checked_Statement super;
 } Checked_Break_Statement;
 
-Checked_Break_Statement *Checked_Break_Statement__create(Source_Location *location);
+Checked_Break_Statement *Checked_Break_Statement__create(Source_Location location);
 
 typedef struct Checked_Expression_Statement {
     Checked_Statement super;
     Checked_Expression *expression;
 } Checked_Expression_Statement;
 
-Checked_Expression_Statement *Checked_Expression_Statement__create(Source_Location *location, Checked_Expression *expression);
+Checked_Expression_Statement *Checked_Expression_Statement__create(Source_Location location, Checked_Expression *expression);
 
 typedef struct Checked_If_Statement {
     Checked_Statement super;
@@ -541,21 +601,21 @@ typedef struct Checked_If_Statement {
     Checked_Statement *false_statement;
 } Checked_If_Statement;
 
-Checked_If_Statement *Checked_If_Statement__create(Source_Location *location, Checked_Expression *condition_expression, Checked_Statement *true_statement, Checked_Statement *false_statement);
+Checked_If_Statement *Checked_If_Statement__create(Source_Location location, Checked_Expression *condition_expression, Checked_Statement *true_statement, Checked_Statement *false_statement);
 
 typedef struct Checked_Loop_Statement {
     Checked_Statement super;
     Checked_Statement *body_statement;
 } Checked_Loop_Statement;
 
-Checked_Loop_Statement *Checked_Loop_Statement__create(Source_Location *location, Checked_Statement *body_statement);
+Checked_Loop_Statement *Checked_Loop_Statement__create(Source_Location location, Checked_Statement *body_statement);
 
 typedef struct Checked_Return_Statement {
     Checked_Statement super;
     Checked_Expression *expression;
 } Checked_Return_Statement;
 
-Checked_Return_Statement *Checked_Return_Statement__create(Source_Location *location, Checked_Expression *expression);
+Checked_Return_Statement *Checked_Return_Statement__create(Source_Location location, Checked_Expression *expression);
 
 typedef struct Checked_Variable_Statement {
     Checked_Statement super;
@@ -564,7 +624,7 @@ typedef struct Checked_Variable_Statement {
     bool is_external;
 } Checked_Variable_Statement;
 
-Checked_Variable_Statement *Checked_Variable_Statement__create(Source_Location *location, Checked_Variable_Symbol *variable, Checked_Expression *expression, bool is_external);
+Checked_Variable_Statement *Checked_Variable_Statement__create(Source_Location location, Checked_Variable_Symbol *variable, Checked_Expression *expression, bool is_external);
 
 typedef struct Checked_While_Statement {
     Checked_Statement super;
@@ -572,7 +632,7 @@ typedef struct Checked_While_Statement {
     Checked_Statement *body_statement;
 } Checked_While_Statement;
 
-Checked_While_Statement *Checked_While_Statement__create(Source_Location *location, Checked_Expression *condition_expression, Checked_Statement *body_statement);
+Checked_While_Statement *Checked_While_Statement__create(Source_Location location, Checked_Expression *condition_expression, Checked_Statement *body_statement);
 
 typedef struct Checked_Source {
     Source *first_source;
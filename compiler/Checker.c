@@ -1,75 +1,122 @@
 /* Copyright (C) 2024 Stefan Selariu */
 
 #include "Checker.h"
+#include "Arena.h"
 #include "File.h"
+#include "Worker.h"
+
+#define CHECKER_METHOD_CACHE_SIZE 256
+
+/* Function bodies are checked by all workers only in batches of at least this many statements */
+#ifndef CHECKER__BATCH_STATEMENTS
+#define CHECKER__BATCH_STATEMENTS 1024
+#endif
+
+typedef struct Checker_Method_Cache_Entry {
+    Checked_Type *receiver_type;
+    String *function_name;
+    size_t labels_hash;
+    Checked_Function_Symbol *function_symbol;
+} Checker_Method_Cache_Entry;
 
 typedef struct Checker {
-    Checked_Named_Type *first_type;
-    Checked_Named_Type *last_type;
-    Checked_Named_Type *last_builting_type;
+    /* Indexed by kind, with NULL for the kinds that are not builtin */
+    Checked_Named_Type *builtin_types[CHECKED_TYPE_KIND__NULL + 1];
+    /* Open addressing table of all named types, keyed by their interned name */
+    Checked_Named_Type **types_table;
+    size_t types_table_size;
+    size_t types_count;
     Checked_Symbols *global_symbols;
     Checked_Symbols *symbols;
+    Checked_Overload_Sets *functions;
+    Checker_Method_Cache_Entry method_cache[CHECKER_METHOD_CACHE_SIZE];
 
     Checked_Type *receiver_type;
     Checked_Type *return_type;
 } Checker;
 
+static const struct {
+    Checked_Type_Kind kind;
+    char *name;
+} builtin_types[] = {
+    {CHECKED_TYPE_KIND__BOOL, "bool"},
+    {CHECKED_TYPE_KIND__I16, "i16"},
+    {CHECKED_TYPE_KIND__I32, "i32"},
+    {CHECKED_TYPE_KIND__I64, "i64"},
+    {CHECKED_TYPE_KIND__I8, "i8"},
+    {CHECKED_TYPE_KIND__ISIZE, "isize"},
+    {CHECKED_TYPE_KIND__U16, "u16"},
+    {CHECKED_TYPE_KIND__U32, "u32"},
+    {CHECKED_TYPE_KIND__U64, "u64"},
+    {CHECKED_TYPE_KIND__U8, "u8"},
+    {CHECKED_TYPE_KIND__ANY, "Any"},
+    {CHECKED_TYPE_KIND__NOTHING, "__nothing__"},
+    {CHECKED_TYPE_KIND__NULL, "null"},
+};
+
 void Checker__append_type(Checker *self, Checked_Named_Type *type);
 
 Checker *Checker__create() {
-    Checker *checker = (Checker *)malloc(sizeof(Checker));
-    checker->first_type = NULL;
-    checker->last_type = NULL;
+    Checker *checker = (Checker *)Arena__allocate(check_arena, sizeof(Checker));
+    memset(checker->builtin_types, 0, sizeof(checker->builtin_types));
+    checker->types_table = NULL;
+    checker->types_table_size = 0;
+    checker->types_count = 0;
     checker->global_symbols = checker->symbols = Checked_Symbols__create(NULL);
+    checker->functions = Checked_Overload_Sets__create();
+    memset(checker->method_cache, 0, sizeof(checker->method_cache));
 
-    Checker__append_type(checker, Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__BOOL, sizeof(Checked_Named_Type), NULL, String__create_from("bool")));
-    Checker__append_type(checker, Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__I16, sizeof(Checked_Named_Type), NULL, String__create_from("i16")));
-    Checker__append_type(checker, Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__I32, sizeof(Checked_Named_Type), NULL, String__create_from("i32")));
-    Checker__append_type(checker, Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__I64, sizeof(Checked_Named_Type), NULL, String__create_from("i64")));
-    Checker__append_type(checker, Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__I8, sizeof(Checked_Named_Type), NULL, String__create_from("i8")));
-    Checker__append_type(checker, Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__ISIZE, sizeof(Checked_Named_Type), NULL, String__create_from("isize")));
-    Checker__append_type(checker, Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__U16, sizeof(Checked_Named_Type), NULL, String__create_from("u16")));
-    Checker__append_type(checker, Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__U32, sizeof(Checked_Named_Type), NULL, String__create_from("u32")));
-    Checker__append_type(checker, Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__U64, sizeof(Checked_Named_Type), NULL, String__create_from("u64")));
-    Checker__append_type(checker, Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__U8, sizeof(Checked_Named_Type), NULL, String__create_from("u8")));
-    Checker__append_type(checker, Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__ANY, sizeof(Checked_Named_Type), NULL, String__create_from("Any")));
-    Checker__append_type(checker, Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__NOTHING, sizeof(Checked_Named_Type), NULL, String__create_from("__nothing__")));
-    Checker__append_type(checker, Checked_Named_Type__create_kind(CHECKED_TYPE_KIND__NULL, sizeof(Checked_Named_Type), NULL, String__create_from("null")));
-    checker->last_builting_type = checker->last_type;
+    for (size_t index = 0; index < sizeof(builtin_types) / sizeof(builtin_types[0]); index++) {
+        Checked_Named_Type *type = Checked_Named_Type__create_kind(builtin_types[index].kind, sizeof(Checked_Named_Type), SOURCE_LOCATION__NONE, String__intern_cstring(builtin_types[index].name));
+        checker->builtin_types[type->super.kind] = type;
+        Checker__append_type(checker, type);
+    }
 
     return checker;
 }
 
+static Checked_Named_Type **Checker__find_type_slot(Checker *self, String *name) {
+    size_t index = String__interned_hash(name) & (self->types_table_size - 1);
+    while (self->types_table[index] != NULL && self->types_table[index]->name != name) {
+        index = (index + 1) & (self->types_table_size - 1);
+    }
+    return &self->types_table[index];
+}
+
+static void Checker__grow_types_table(Checker *self) {
+    Checked_Named_Type **old_table = self->types_table;
+    size_t old_table_size = self->types_table_size;
+
+    self->types_table_size = old_table_size == 0 ? 64 : old_table_size * 2;
+    self->types_table = (Checked_Named_Type **)Arena__allocate(check_arena, self->types_table_size * sizeof(Checked_Named_Type *));
+    memset(self->types_table, 0, self->types_table_size * sizeof(Checked_Named_Type *));
+    for (size_t index = 0; index < old_table_size; index++) {
+        if (old_table[index] != NULL) {
+            *Checker__find_type_slot(self, old_table[index]->name) = old_table[index];
+        }
+    }
+}
+
 void Checker__append_type(Checker *self, Checked_Named_Type *type) {
-    if (self->first_type == NULL) {
-        self->first_type = type;
-    } else {
-        self->last_type->super.next_type = (Checked_Type *)type;
+    if ((self->types_count + 1) * 2 > self->types_table_size) {
+        Checker__grow_types_table(self);
+    }
+    Checked_Named_Type **slot = Checker__find_type_slot(self, type->name);
+    if (*slot == NULL) {
+        *slot = type;
+        self->types_count = self->types_count + 1;
     }
-    self->last_type = type;
 
     Checked_Symbols__append_symbol(self->symbols, (Checked_Symbol *)Checked_Type_Symbol__create(type->super.location, type->name, type));
 }
 
 Checked_Named_Type *Checker__find_type(Checker *self, String *name) {
-    Checked_Named_Type *type = self->first_type;
-    while (type != NULL) {
-        if (String__equals_string(name, type->name)) {
-            break;
-        }
-        type = (Checked_Named_Type *)type->super.next_type;
-    }
-    return type;
+    return *Checker__find_type_slot(self, name);
 }
 
 Checked_Named_Type *Checker__get_builtin_type(Checker *self, Checked_Type_Kind kind) {
-    Checked_Named_Type *type = self->first_type;
-    Checked_Named_Type *custom_type = (Checked_Named_Type *)self->last_builting_type->super.next_type;
-    while (type != custom_type) {
-        if (type->super.kind == kind) {
-            return type;
-        }
-        type = (Checked_Named_Type *)type->super.next_type;
+    if (kind <= CHECKED_TYPE_KIND__NULL && self->builtin_types[kind] != NULL) {
+        return self->builtin_types[kind];
     }
     pWriter__style(stderr_writer, WRITER_STYLE__ERROR);
     pWriter__write__cstring(stderr_writer, "No such builtin type");
@@ -134,7 +181,7 @@ Checked_Type *Checker__resolve_type(Checker *self, Parsed_Type *parsed_type) {
     todo("Handle unexpected Parsed_Type_Kind");
 }
 
-void Checker__require_numeric_type(Checker *self, Checked_Type *type, Source_Location *location) {
+void Checker__require_numeric_type(Checker *self, Checked_Type *type, Source_Location location) {
     if (!Checked_Type__is_numeric_type(type)) {
         pWriter__begin_location_message(stderr_writer, location, WRITER_STYLE__ERROR);
         pWriter__write__cstring(stderr_writer, "Expected numeric type");
@@ -143,7 +190,7 @@ void Checker__require_numeric_type(Checker *self, Checked_Type *type, Source_Loc
     }
 }
 
-void Checker__require_same_type(Checker *self, Checked_Type *expected_type, Checked_Type *actual_type, Source_Location *location) {
+void Checker__require_same_type(Checker *self, Checked_Type *expected_type, Checked_Type *actual_type, Source_Location location) {
     if (expected_type->kind == CHECKED_TYPE_KIND__POINTER && actual_type->kind == CHECKED_TYPE_KIND__NULL) {
         return;
     }
@@ -200,55 +247,96 @@ Checked_Expression *Checker__check_bool_expression(Checker *self, Parsed_Bool_Ex
     return (Checked_Expression *)Checked_Bool_Expression__create(parsed_expression->super.super.location, expression_type, value);
 }
 
-Checked_Function_Symbol *Checker__find_function_symbol(Checker *self, String *function_name, Parsed_Call_Argument *first_call_argument, Checked_Type *receiver_type, int *similars) {
-    Checked_Symbol *symbol = self->global_symbols->first_symbol;
-    for (; symbol != NULL; symbol = symbol->next_symbol) {
-        if (symbol->kind == CHECKED_SYMBOL_KIND__FUNCTION) {
-            Checked_Function_Symbol *function_symbol = (Checked_Function_Symbol *)symbol;
-            if (String__equals_string(function_symbol->function_name, function_name)) {
-                (*similars)++;
-                Checked_Function_Parameter *function_parameter = function_symbol->function_type->first_parameter;
-                if (receiver_type != NULL) {
-                    if (function_symbol->receiver_type == NULL || !Checked_Type__equals(function_symbol->receiver_type, receiver_type)) {
-                        continue;
-                    }
-                    if (function_parameter == NULL || !Checked_Type__equals(function_parameter->type, receiver_type)) {
-                        panic();
-                    }
-                    function_parameter = function_parameter->next_parameter;
-                }
-                Parsed_Call_Argument *call_argument = first_call_argument;
-                while (function_parameter != NULL && call_argument != NULL) {
-                    if (function_parameter->label == NULL) {
-                        if (call_argument->name != NULL) {
-                            break;
-                        }
-                    } else if (call_argument->name == NULL || !String__equals_string(function_parameter->label, call_argument->name->super.lexeme)) {
-                        break;
-                    }
-                    function_parameter = function_parameter->next_parameter;
-                    call_argument = call_argument->next_argument;
-                }
-                if (function_parameter == NULL && call_argument == NULL) {
-                    return function_symbol;
-                }
+bool Checker__matches_call_arguments(Checked_Function_Parameter *function_parameter, Parsed_Call_Argument *call_argument) {
+    while (function_parameter != NULL && call_argument != NULL) {
+        if (function_parameter->label == NULL) {
+            if (call_argument->name != NULL) {
+                return false;
             }
+        } else if (call_argument->name == NULL || function_parameter->label != call_argument->name->lexeme) {
+            return false;
+        }
+        function_parameter = function_parameter->next_parameter;
+        call_argument = call_argument->next_argument;
+    }
+    return function_parameter == NULL && call_argument == NULL;
+}
+
+Checked_Function_Symbol *Checker__find_method_symbol(Checker *self, String *function_name, Parsed_Call_Argument *first_call_argument, size_t labels_hash, Checked_Type *receiver_type) {
+    size_t cache_index = (Checked_Type__hash(receiver_type) * 31 + String__interned_hash(function_name) * 7 + labels_hash) & (CHECKER_METHOD_CACHE_SIZE - 1);
+    Checker_Method_Cache_Entry *cache_entry = &self->method_cache[cache_index];
+    if (cache_entry->function_name == function_name && cache_entry->labels_hash == labels_hash && Checked_Type__equals(cache_entry->receiver_type, receiver_type)) {
+        if (Checker__matches_call_arguments(cache_entry->function_symbol->function_type->first_parameter->next_parameter, first_call_argument)) {
+            return cache_entry->function_symbol;
+        }
+    }
+
+    Checked_Named_Type *receiver_named_type = Checked_Type__base_named_type(receiver_type);
+    if (receiver_named_type == NULL || receiver_named_type->methods == NULL) {
+        return NULL;
+    }
+    Checked_Overload_Set *overload_set = Checked_Overload_Sets__find(receiver_named_type->methods, function_name);
+    if (overload_set == NULL) {
+        return NULL;
+    }
+    for (size_t index = 0; index < overload_set->overloads_count; index++) {
+        Checked_Overload *overload = &overload_set->overloads[index];
+        Checked_Function_Symbol *function_symbol = overload->function_symbol;
+        if (!Checked_Type__equals(function_symbol->receiver_type, receiver_type)) {
+            continue;
+        }
+        Checked_Function_Parameter *function_parameter = function_symbol->function_type->first_parameter;
+        if (function_parameter == NULL || !Checked_Type__equals(function_parameter->type, receiver_type)) {
+            panic();
+        }
+        if (overload->receiver_labels_hash == labels_hash && Checker__matches_call_arguments(function_parameter->next_parameter, first_call_argument)) {
+            cache_entry->receiver_type = receiver_type;
+            cache_entry->function_name = function_name;
+            cache_entry->labels_hash = labels_hash;
+            cache_entry->function_symbol = function_symbol;
+            return function_symbol;
+        }
+    }
+    return NULL;
+}
+
+Checked_Function_Symbol *Checker__find_function_symbol(Checker *self, String *function_name, Parsed_Call_Argument *first_call_argument, Checked_Type *receiver_type, int *similars) {
+    Checked_Overload_Set *overload_set = Checked_Overload_Sets__find(self->functions, function_name);
+    if (overload_set == NULL) {
+        return NULL;
+    }
+    *similars = *similars + (int)overload_set->overloads_count;
+
+    size_t labels_hash = 0;
+    Parsed_Call_Argument *call_argument = first_call_argument;
+    while (call_argument != NULL) {
+        labels_hash = Checked_Labels_Hash__append(labels_hash, call_argument->name != NULL ? call_argument->name->lexeme : NULL);
+        call_argument = call_argument->next_argument;
+    }
+
+    if (receiver_type != NULL) {
+        return Checker__find_method_symbol(self, function_name, first_call_argument, labels_hash, receiver_type);
+    }
+
+    for (size_t index = 0; index < overload_set->overloads_count; index++) {
+        Checked_Overload *overload = &overload_set->overloads[index];
+        if (overload->labels_hash == labels_hash && Checker__matches_call_arguments(overload->function_symbol->function_type->first_parameter, first_call_argument)) {
+            return overload->function_symbol;
         }
     }
     return NULL;
 }
 
 Checked_Function_Symbol *Checker__find_function_symbol_by_type(Checker *self, String *function_name, Checked_Function_Type *function_type, int *similars) {
-    Checked_Symbol *symbol = self->global_symbols->first_symbol;
-    for (; symbol != NULL; symbol = symbol->next_symbol) {
-        if (symbol->kind == CHECKED_SYMBOL_KIND__FUNCTION) {
-            Checked_Function_Symbol *function_symbol = (Checked_Function_Symbol *)symbol;
-            if (String__equals_string(function_symbol->function_name, function_name)) {
-                (*similars)++;
-                if (Checked_Function_Type__equals(function_symbol->function_type, function_type)) {
-                    return function_symbol;
-                }
-            }
+    Checked_Overload_Set *overload_set = Checked_Overload_Sets__find(self->functions, function_name);
+    if (overload_set == NULL) {
+        return NULL;
+    }
+    for (size_t index = 0; index < overload_set->overloads_count; index++) {
+        Checked_Function_Symbol *function_symbol = overload_set->overloads[index].function_symbol;
+        (*similars)++;
+        if (Checked_Function_Type__equals(function_symbol->function_type, function_type)) {
+            return function_symbol;
         }
     }
     return NULL;
@@ -293,7 +381,7 @@ Checked_Callable Checker__check_callable_symbol(Checker *self, Token *symbol_nam
             Parsed_Call_Argument *parsed_argument = first_parsed_argument;
             while (parsed_argument != NULL) {
                 if (parsed_argument->name != NULL) {
-                    pWriter__write__string(stderr_writer, parsed_argument->name->super.lexeme);
+                    pWriter__write__string(stderr_writer, parsed_argument->name->lexeme);
                     pWriter__write__cstring(stderr_writer, ": ");
                 }
                 Checked_Type *argument_type = Checker__check_expression(self, parsed_argument->expression, NULL)->type;
@@ -310,16 +398,12 @@ Checked_Callable Checker__check_callable_symbol(Checker *self, Token *symbol_nam
             pWriter__begin_location_message(stderr_writer, symbol_name->location, WRITER_STYLE__WARNING);
             pWriter__write__cstring(stderr_writer, "Similar callables:");
             pWriter__end_line(stderr_writer);
-            Checked_Symbol *symbol = self->global_symbols->first_symbol;
-            for (; symbol != NULL; symbol = symbol->next_symbol) {
-                if (symbol->kind == CHECKED_SYMBOL_KIND__FUNCTION) {
-                    function_symbol = (Checked_Function_Symbol *)symbol;
-                    if (String__equals_string(function_symbol->function_name, symbol_name->lexeme)) {
-                        pWriter__begin_location_message(stderr_writer, function_symbol->super.location, WRITER_STYLE__WARNING);
-                        pWriter__write__checked_function_symbol(stderr_writer, function_symbol);
-                        pWriter__end_location_message(stderr_writer);
-                    }
-                }
+            Checked_Overload_Set *overload_set = Checked_Overload_Sets__find(self->functions, symbol_name->lexeme);
+            for (size_t index = 0; index < overload_set->overloads_count; index++) {
+                function_symbol = overload_set->overloads[index].function_symbol;
+                pWriter__begin_location_message(stderr_writer, function_symbol->super.location, WRITER_STYLE__WARNING);
+                pWriter__write__checked_function_symbol(stderr_writer, function_symbol);
+                pWriter__end_location_message(stderr_writer);
             }
             panic();
         }
@@ -370,7 +454,7 @@ Checked_Callable Checker__check_callable_member(Checker *self, Parsed_Member_Acc
         }
         Checked_Trait_Method *trait_method = trait_type->first_method;
         for (; trait_method != NULL; trait_method = trait_method->next_method) {
-            if (String__equals_string(trait_method->name, parsed_callee_expression->member_name->lexeme)) {
+            if (trait_method->name == parsed_callee_expression->member_name->lexeme) {
                 return (Checked_Callable){
                     .function_type = trait_method->function_type,
                     .callee_expression = (Checked_Expression *)Checked_Member_Access_Expression__create(parsed_callee_expression->super.location, trait_method->struct_member->type, object_expression, trait_method->struct_member),
@@ -593,7 +677,7 @@ Checked_Expression *Checker__check_make_struct_expression(Checker *self, Parsed_
                 pWriter__end_location_message(stderr_writer);
                 panic();
             }
-            Checked_Struct_Member *struct_member = Checked_Struct_Type__find_member(struct_type, parsed_argument->name->super.lexeme);
+            Checked_Struct_Member *struct_member = Checked_Struct_Type__find_member(struct_type, parsed_argument->name->lexeme);
             if (struct_member == NULL) {
                 pWriter__begin_location_message(stderr_writer, parsed_argument->location, WRITER_STYLE__ERROR);
                 pWriter__write__cstring(stderr_writer, "No such struct member");
@@ -660,10 +744,11 @@ Checked_Expression *Checker__check_make_trait_expression(Checker *self, Parsed_M
     Checked_Trait_Method *trait_method;
     for (trait_method = trait_type->first_method; trait_method != NULL; trait_method = trait_method->next_method) {
         int32_t function_symbol_similars = 0;
-        Checked_Type *saved_first_parameter_type = trait_method->function_type->first_parameter->type;
-        trait_method->function_type->first_parameter->type = self_expression->type;
-        Checked_Function_Symbol *function_symbol = Checker__find_function_symbol_by_type(self, trait_method->name, trait_method->function_type, &function_symbol_similars);
-        trait_method->function_type->first_parameter->type = saved_first_parameter_type;
+        Checked_Function_Parameter *trait_method_first_parameter = trait_method->function_type->first_parameter;
+        Checked_Function_Parameter *self_first_parameter = Checked_Function_Parameter__create(trait_method_first_parameter->location, trait_method_first_parameter->label, trait_method_first_parameter->name, self_expression->type);
+        self_first_parameter->next_parameter = trait_method_first_parameter->next_parameter;
+        Checked_Function_Type *self_function_type = Checked_Function_Type__create(trait_method->location, self_first_parameter, trait_method->function_type->return_type);
+        Checked_Function_Symbol *function_symbol = Checker__find_function_symbol_by_type(self, trait_method->name, self_function_type, &function_symbol_similars);
         if (function_symbol != NULL) {
             Checked_Symbol_Expression *function_symbol_expression = Checked_Symbol_Expression__create(parsed_expression->super.location, function_symbol->super.type, (Checked_Symbol *)function_symbol);
             Checked_Cast_Expression *trait_struct_member_argument_expression = Checked_Cast_Expression__create(parsed_expression->super.location, trait_method->struct_member->type, (Checked_Expression *)function_symbol_expression);
@@ -795,13 +880,11 @@ Checked_Expression *Checker__check_substract_expression(Checker *self, Parsed_Su
 
 Checked_Expression *Checker__check_symbol_expression(Checker *self, Parsed_Symbol_Expression *parsed_expression, Checked_Type *expected_type) {
     if (expected_type != NULL && expected_type->kind == CHECKED_TYPE_KIND__FUNCTION_POINTER) {
-        Checked_Symbol *symbol = self->global_symbols->first_symbol;
-        for (; symbol != NULL; symbol = symbol->next_symbol) {
-            if (symbol->kind == CHECKED_SYMBOL_KIND__FUNCTION) {
-                Checked_Function_Symbol *function_symbol = (Checked_Function_Symbol *)symbol;
-                if (String__equals_string(function_symbol->function_name, parsed_expression->name->lexeme) && Checked_Type__equals(symbol->type, expected_type)) {
-                    return (Checked_Expression *)Checked_Symbol_Expression__create(parsed_expression->super.location, expected_type, symbol);
-                }
+        Checked_Overload_Set *overload_set = Checked_Overload_Sets__find(self->functions, parsed_expression->name->lexeme);
+        for (size_t index = 0; overload_set != NULL && index < overload_set->overloads_count; index++) {
+            Checked_Symbol *symbol = (Checked_Symbol *)overload_set->overloads[index].function_symbol;
+            if (Checked_Type__equals(symbol->type, expected_type)) {
+                return (Checked_Expression *)Checked_Symbol_Expression__create(parsed_expression->super.location, expected_type, symbol);
             }
         }
         pWriter__begin_location_message(stderr_writer, parsed_expression->name->location, WRITER_STYLE__ERROR);
@@ -815,12 +898,10 @@ Checked_Expression *Checker__check_symbol_expression(Checker *self, Parsed_Symbo
         if (expected_type == NULL) {
             Checked_Symbol *function_symbol = NULL;
             int function_simbols = 0;
-            symbol = self->global_symbols->first_symbol;
-            for (; symbol != NULL; symbol = symbol->next_symbol) {
-                if (symbol->kind == CHECKED_SYMBOL_KIND__FUNCTION && String__equals_string(((Checked_Function_Symbol *)symbol)->function_name, parsed_expression->name->lexeme)) {
-                    function_symbol = symbol;
-                    function_simbols++;
-                }
+            Checked_Overload_Set *overload_set = Checked_Overload_Sets__find(self->functions, parsed_expression->name->lexeme);
+            if (overload_set != NULL) {
+                function_symbol = (Checked_Symbol *)overload_set->overloads[0].function_symbol;
+                function_simbols = (int)overload_set->overloads_count;
             }
             if (function_simbols == 1) {
                 return (Checked_Expression *)Checked_Symbol_Expression__create(parsed_expression->super.location, function_symbol->type, function_symbol);
@@ -931,7 +1012,7 @@ void Checker__check_struct_statement(Checker *self, Parsed_Struct_Statement *par
     Checked_Named_Type *other_type = Checker__find_type(self, parsed_statement->super.name->lexeme);
     Checked_Struct_Type *struct_type;
     if (other_type != NULL) {
-        if (other_type->super.kind != CHECKED_TYPE_KIND__STRUCT || (((Checked_Struct_Type *)other_type)->first_member != NULL)) {
+        if (other_type->super.kind != CHECKED_TYPE_KIND__STRUCT || (((Checked_Struct_Type *)other_type)->members_count > 0)) {
             todo("Report type redeclaration");
         }
         struct_type = (Checked_Struct_Type *)other_type;
@@ -941,27 +1022,28 @@ void Checker__check_struct_statement(Checker *self, Parsed_Struct_Statement *par
     }
 
     if (parsed_statement->first_member != NULL) {
-        Checked_Struct_Member *last_struct_member = NULL;
+        size_t members_count = 0;
         Parsed_Struct_Member *parsed_member = parsed_statement->first_member;
+        for (; parsed_member != NULL; parsed_member = parsed_member->next_member) {
+            members_count = members_count + 1;
+        }
+        Checked_Struct_Type__reserve_members(struct_type, members_count);
+
+        parsed_member = parsed_statement->first_member;
         while (parsed_member != NULL) {
             Checked_Struct_Member *struct_member = Checked_Struct_Type__find_member(struct_type, parsed_member->name->lexeme);
             if (struct_member != NULL) {
                 todo("Report duplicate struct member declaration");
             }
             Checked_Type *struct_member_type = Checker__resolve_type(self, parsed_member->type);
-            struct_member = Checked_Struct_Member__create(parsed_member->name->location, parsed_member->name->lexeme, struct_member_type);
-            if (last_struct_member == NULL) {
-                struct_type->first_member = struct_member;
-            } else {
-                last_struct_member->next_member = struct_member;
-            }
-            last_struct_member = struct_member;
+            Checked_Struct_Type__append_member(struct_type, parsed_member->name->location, parsed_member->name->lexeme, struct_member_type);
             parsed_member = parsed_member->next_member;
         }
     }
+    Checked_Struct_Type__compute_layout(struct_type);
 }
 
-Checked_Function_Type *Checker__check_function_type(Checker *self, Source_Location *location, Parsed_Function_Parameter *first_parsed_parameter, Parsed_Type *parsed_return_type) {
+Checked_Function_Type *Checker__check_function_type(Checker *self, Source_Location location, Parsed_Function_Parameter *first_parsed_parameter, Parsed_Type *parsed_return_type) {
     Checked_Type *function_return_type;
     if (parsed_return_type != NULL) {
         function_return_type = Checker__resolve_type(self, parsed_return_type);
@@ -998,18 +1080,22 @@ void Checker__check_trait_statement(Checker *self, Parsed_Trait_Statement *parse
 
     trait_type->struct_type = Checked_Struct_Type__create(parsed_statement->super.name->location, trait_type->super.name);
 
-    Checked_Type *trait_receiver_type = (Checked_Type *)Checked_Pointer_Type__create(NULL, (Checked_Type *)Checker__get_builtin_type(self, CHECKED_TYPE_KIND__ANY));
-    trait_type->self_struct_member = trait_type->struct_type->first_member = Checked_Struct_Member__create(NULL, String__create_from("self"), trait_receiver_type);
-
+    Checked_Type *trait_receiver_type = (Checked_Type *)Checked_Pointer_Type__create(SOURCE_LOCATION__NONE, (Checked_Type *)Checker__get_builtin_type(self, CHECKED_TYPE_KIND__ANY));
+    size_t members_count = 1;
     Parsed_Trait_Method *parsed_method = parsed_statement->first_method;
+    for (; parsed_method != NULL; parsed_method = parsed_method->next_method) {
+        members_count = members_count + 1;
+    }
+    Checked_Struct_Type__reserve_members(trait_type->struct_type, members_count);
+    trait_type->self_struct_member = Checked_Struct_Type__append_member(trait_type->struct_type, SOURCE_LOCATION__NONE, String__intern_cstring("self"), trait_receiver_type);
+
+    parsed_method = parsed_statement->first_method;
     if (parsed_method != NULL) {
         self->receiver_type = trait_receiver_type;
-        Checked_Struct_Member *last_struct_member = trait_type->struct_type->first_member;
         Checked_Trait_Method *last_trait_method = NULL;
         for (; parsed_method != NULL; parsed_method = parsed_method->next_method) {
             Checked_Function_Type *function_type = Checker__check_function_type(self, parsed_method->location, parsed_method->first_parameter, parsed_method->return_type);
-            Checked_Struct_Member *trait_method_struct_member = Checked_Struct_Member__create(NULL, parsed_method->name->lexeme, (Checked_Type *)Checked_Function_Pointer_Type__create(NULL, function_type));
-            last_struct_member = last_struct_member->next_member = trait_method_struct_member;
+            Checked_Struct_Member *trait_method_struct_member = Checked_Struct_Type__append_member(trait_type->struct_type, SOURCE_LOCATION__NONE, parsed_method->name->lexeme, (Checked_Type *)Checked_Function_Pointer_Type__create(SOURCE_LOCATION__NONE, function_type));
             Checked_Trait_Method *trait_method = Checked_Trait_Method__create(parsed_method->location, parsed_method->name->lexeme, function_type, trait_method_struct_member);
             if (last_trait_method == NULL) {
                 trait_type->first_method = trait_method;
@@ -1019,6 +1105,7 @@ void Checker__check_trait_statement(Checker *self, Parsed_Trait_Statement *parse
             last_trait_method = trait_method;
         }
     }
+    Checked_Struct_Type__compute_layout(trait_type->struct_type);
 }
 
 Checked_Statement *Checker__check_statement(Checker *self, Parsed_Statement *parsed_statement);
@@ -1178,7 +1265,17 @@ void Checker__check_function_declaration(Checker *self, Parsed_Function_Statemen
         function_parameter_index++;
     }
 
-    Checked_Symbols__append_symbol(self->symbols, (Checked_Symbol *)Checked_Function_Symbol__create(parsed_statement->super.name->location, symbol_name, function_name, function_type, receiver_type));
+    Checked_Function_Symbol *function_symbol = Checked_Function_Symbol__create(parsed_statement->super.name->location, String__intern(symbol_name), function_name, function_type, receiver_type);
+    Checked_Symbols__append_symbol(self->symbols, (Checked_Symbol *)function_symbol);
+    Checked_Overload_Sets__add(self->functions, function_symbol);
+    if (receiver_type != NULL) {
+        Checked_Named_Type *receiver_named_type = Checked_Type__base_named_type(receiver_type);
+        if (receiver_named_type->methods == NULL) {
+            receiver_named_type->methods = Checked_Overload_Sets__create();
+        }
+        Checked_Overload_Sets__add(receiver_named_type->methods, function_symbol);
+    }
+    String__delete(symbol_name);
 }
 
 Checked_Statement *Checker__check_statement(Checker *self, Parsed_Statement *parsed_statement) {
@@ -1213,11 +1310,10 @@ Checked_Statements *Checker__check_statements(Checker *self, Parsed_Statements *
     self->symbols = Checked_Symbols__create(self->symbols);
 
     Checked_Statements *checked_statements = Checked_Statements__create();
-    Parsed_Statement *parsed_statement = parsed_statements->first_statement;
-    while (parsed_statement != NULL) {
+    for (uint32_t statement_index = 0; statement_index < parsed_statements->statements_count; statement_index++) {
+        Parsed_Statement *parsed_statement = parsed_statements->statements[statement_index];
         Checked_Statement *checked_statement = Checker__check_statement(self, parsed_statement);
         Checked_Statements__append(checked_statements, checked_statement);
-        parsed_statement = parsed_statement->next_statement;
     }
 
     /* Pop block symbols */
@@ -1227,15 +1323,13 @@ Checked_Statements *Checker__check_statements(Checker *self, Parsed_Statements *
 }
 
 void Checker__check_function_definition(Checker *self, Parsed_Function_Statement *parsed_statement) {
-    Checked_Symbol *symbol = self->symbols->first_symbol;
-    while (symbol != NULL) {
-        if (symbol->kind == CHECKED_SYMBOL_KIND__FUNCTION) {
-            Checked_Function_Symbol *function_symbol = (Checked_Function_Symbol *)symbol;
-            if (function_symbol->function_name == parsed_statement->super.name->lexeme) {
-                break;
-            }
+    Checked_Symbol *symbol = NULL;
+    Checked_Overload_Set *overload_set = Checked_Overload_Sets__find(self->functions, parsed_statement->super.name->lexeme);
+    for (size_t index = 0; overload_set != NULL && index < overload_set->overloads_count; index++) {
+        if (overload_set->overloads[index].function_symbol->super.location == parsed_statement->super.name->location) {
+            symbol = (Checked_Symbol *)overload_set->overloads[index].function_symbol;
+            break;
         }
-        symbol = symbol->next_symbol;
     }
     if (symbol == NULL) {
         // Function symbol should exist
@@ -1270,14 +1364,83 @@ void Checker__check_function_definition(Checker *self, Parsed_Function_Statement
     self->symbols = self->symbols->parent;
 }
 
+typedef struct Checker_Function_Definitions {
+    Parsed_Function_Statement **function_statements;
+    size_t function_statements_count;
+    size_t function_statements_size;
+} Checker_Function_Definitions;
+
+static void Checker_Function_Definitions__append(Checker_Function_Definitions *self, Parsed_Function_Statement *function_statement) {
+    if (self->function_statements_count == self->function_statements_size) {
+        self->function_statements_size = self->function_statements_size == 0 ? 64 : self->function_statements_size * 2;
+        self->function_statements = (Parsed_Function_Statement **)realloc(self->function_statements, self->function_statements_size * sizeof(Parsed_Function_Statement *));
+    }
+    self->function_statements[self->function_statements_count] = function_statement;
+    self->function_statements_count = self->function_statements_count + 1;
+}
+
+typedef struct Checker_Function_Task {
+    /* The global symbols and types are only read, while the scope state and the method cache are private */
+    Checker checker;
+    Parsed_Function_Statement **function_statements;
+    size_t function_statements_count;
+} Checker_Function_Task;
+
+static void Checker_Function_Task__check(Checker_Function_Task *self) {
+    for (size_t index = 0; index < self->function_statements_count; index++) {
+        Checker__check_function_definition(&self->checker, self->function_statements[index]);
+    }
+}
+
+/*
+ * Once all the declarations are collected, function bodies are checked independently. So they
+ * are checked by all workers, in batches of consecutive functions, and their diagnostics are
+ * reported in source order. The bodies are measured by their top level statements, so that small
+ * programs don't pay for the threads. The collected function definitions are cleared.
+ */
+static void Checker__check_function_definitions(Checker *self, Checker_Function_Definitions *definitions) {
+    size_t functions_count = definitions->function_statements_count;
+    size_t statements_count = 0;
+    for (size_t index = 0; index < functions_count; index++) {
+        Parsed_Statements *statements = definitions->function_statements[index]->statements;
+        statements_count = statements_count + (statements != NULL ? statements->statements_count : 0);
+    }
+    size_t tasks_count = Workers__count() * 4 < functions_count ? Workers__count() * 4 : functions_count;
+    if (statements_count / CHECKER__BATCH_STATEMENTS < tasks_count) {
+        tasks_count = statements_count / CHECKER__BATCH_STATEMENTS;
+    }
+    if (Workers__count() == 1 || tasks_count < 2) {
+        for (size_t index = 0; index < functions_count; index++) {
+            Checker__check_function_definition(self, definitions->function_statements[index]);
+        }
+    } else {
+        Checker_Function_Task *function_tasks = (Checker_Function_Task *)malloc(tasks_count * sizeof(Checker_Function_Task));
+        Worker_Task *tasks = (Worker_Task *)malloc(tasks_count * sizeof(Worker_Task));
+        size_t functions_index = 0;
+        for (size_t task_index = 0; task_index < tasks_count; task_index++) {
+            size_t next_functions_index = functions_count * (task_index + 1) / tasks_count;
+            function_tasks[task_index].checker = *self;
+            function_tasks[task_index].function_statements = definitions->function_statements + functions_index;
+            function_tasks[task_index].function_statements_count = next_functions_index - functions_index;
+            tasks[task_index] = (Worker_Task){.run = (void (*)(void *))Checker_Function_Task__check, .data = &function_tasks[task_index]};
+            functions_index = next_functions_index;
+        }
+        Workers__run(tasks, tasks_count);
+        Workers__report(tasks, tasks_count);
+        free(tasks);
+        free(function_tasks);
+    }
+    definitions->function_statements_count = 0;
+}
+
 Checked_Source *Checker__check_source(Checker *self, Parsed_Source *parsed_source) {
     Checked_Statements *checked_statements = Checked_Statements__create();
 
     Parsed_Statement *parsed_statement;
 
     /* Check all declared types */
-    parsed_statement = parsed_source->statements->first_statement;
-    while (parsed_statement != NULL) {
+    for (uint32_t statement_index = 0; statement_index < parsed_source->statements->statements_count; statement_index++) {
+        parsed_statement = parsed_source->statements->statements[statement_index];
         switch (parsed_statement->kind) {
         case PARSED_STATEMENT_KIND__EXTERNAL_TYPE:
             Checker__check_external_type_statement(self, (Parsed_External_Type_Statement *)parsed_statement);
@@ -1289,12 +1452,11 @@ Checked_Source *Checker__check_source(Checker *self, Parsed_Source *parsed_sourc
             Checker__check_trait_statement(self, (Parsed_Trait_Statement *)parsed_statement);
             break;
         }
-        parsed_statement = parsed_statement->next_statement;
     }
 
     /* Collect other declarations */
-    parsed_statement = parsed_source->statements->first_statement;
-    while (parsed_statement != NULL) {
+    for (uint32_t statement_index = 0; statement_index < parsed_source->statements->statements_count; statement_index++) {
+        parsed_statement = parsed_source->statements->statements[statement_index];
         Checked_Statement *checked_statement = NULL;
         switch (parsed_statement->kind) {
         case PARSED_STATEMENT_KIND__EXTERNAL_TYPE:
@@ -1331,12 +1493,12 @@ Checked_Source *Checker__check_source(Checker *self, Parsed_Source *parsed_sourc
         if (checked_statement != NULL) {
             Checked_Statements__append(checked_statements, checked_statement);
         }
-        parsed_statement = parsed_statement->next_statement;
     }
 
     /* Check function definitions */
-    parsed_statement = parsed_source->statements->first_statement;
-    while (parsed_statement != NULL) {
+    Checker_Function_Definitions definitions = {.function_statements = NULL, .function_statements_count = 0, .function_statements_size = 0};
+    for (uint32_t statement_index = 0; statement_index < parsed_source->statements->statements_count; statement_index++) {
+        parsed_statement = parsed_source->statements->statements[statement_index];
         switch (parsed_statement->kind) {
         case PARSED_STATEMENT_KIND__EXTERNAL_TYPE:
             /* ignored */
@@ -1345,13 +1507,15 @@ Checked_Source *Checker__check_source(Checker *self, Parsed_Source *parsed_sourc
             Parsed_Function_Statement *function_statement = (Parsed_Function_Statement *)parsed_statement;
             if (!function_statement->is_external) {
                 if (function_statement->statements == NULL) {
+                    Checker__check_function_definitions(self, &definitions);
                     pWriter__begin_location_message(stderr_writer, function_statement->super.name->location, WRITER_STYLE__ERROR);
                     pWriter__write__cstring(stderr_writer, "Missing function body");
                     pWriter__end_location_message(stderr_writer);
                     panic();
                 }
-                Checker__check_function_definition(self, function_statement);
+                Checker_Function_Definitions__append(&definitions, function_statement);
             } else if (function_statement->statements != NULL) {
+                Checker__check_function_definitions(self, &definitions);
                 pWriter__begin_location_message(stderr_writer, function_statement->super.name->location, WRITER_STYLE__ERROR);
                 pWriter__write__cstring(stderr_writer, "External function with body");
                 pWriter__end_location_message(stderr_writer);
@@ -1363,7 +1527,7 @@ Checked_Source *Checker__check_source(Checker *self, Parsed_Source *parsed_sourc
             Parsed_Struct_Statement *parsed_struct_statement = (Parsed_Struct_Statement *)parsed_statement;
             Parsed_Struct_Method *parsed_struct_method = parsed_struct_statement->first_method;
             while (parsed_struct_method != NULL) {
-                Checker__check_function_definition(self, parsed_struct_method->function_statement);
+                Checker_Function_Definitions__append(&definitions, parsed_struct_method->function_statement);
                 parsed_struct_method = parsed_struct_method->next_method;
             }
             break;
@@ -1375,15 +1539,17 @@ Checked_Source *Checker__check_source(Checker *self, Parsed_Source *parsed_sourc
             /* ignored */
             break;
         default:
+            Checker__check_function_definitions(self, &definitions);
             pWriter__begin_location_message(stderr_writer, parsed_statement->location, WRITER_STYLE__ERROR);
             pWriter__write__cstring(stderr_writer, "Unsupported statement");
             pWriter__end_location_message(stderr_writer);
             panic();
         }
-        parsed_statement = parsed_statement->next_statement;
     }
+    Checker__check_function_definitions(self, &definitions);
+    free(definitions.function_statements);
 
-    Checked_Source *checked_source = (Checked_Source *)malloc(sizeof(Checked_Source));
+    Checked_Source *checked_source = (Checked_Source *)Arena__allocate(check_arena, sizeof(Checked_Source));
     checked_source->first_source = parsed_source->first_source;
     checked_source->first_symbol = self->symbols->first_symbol;
     checked_source->statements = checked_statements;
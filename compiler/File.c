@@ -2,18 +2,48 @@
 
 #include "File.h"
 
-static void file_write_char(FILE *file, char c) {
-    fputc(c, file);
+#include <errno.h>
+#include <unistd.h>
+
+static void file_write_bytes(FILE *file, const char *bytes, size_t length) {
+    fwrite(bytes, 1, length, file);
+}
+
+Writer *File__create_writer(FILE *file, size_t buffer_size) {
+    return Writer__create(file, (void (*)(void *, const char *, size_t))file_write_bytes, buffer_size);
 }
 
-static Writer *File__create_writer(FILE *file) {
-    return Writer__create(file, (void (*)(void *, char))file_write_char);
+static void fd_write_bytes(void *object, const char *bytes, size_t length) {
+    int fd = (int)(intptr_t)object;
+    while (length > 0) {
+        ssize_t count = write(fd, bytes, length);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fprintf(stderr, "Failed to write: %s\n", strerror(errno));
+            panic();
+        }
+        bytes = bytes + count;
+        length = length - (size_t)count;
+    }
+}
+
+Writer *File__create_fd_writer(int fd, size_t buffer_size) {
+    return Writer__create((void *)(intptr_t)fd, fd_write_bytes, buffer_size);
 }
 
 Writer *stdout_writer = NULL;
-Writer *stderr_writer = NULL;
+_Thread_local Writer *stderr_writer = NULL;
+
+static void File__flush_writers() {
+    pWriter__flush(stdout_writer);
+}
 
 void File__init() {
-    stdout_writer = File__create_writer(stdout);
-    stderr_writer = File__create_writer(stderr);
+    /* Written straight to the file descriptor, without a second buffer in stdio */
+    stdout_writer = File__create_fd_writer(STDOUT_FILENO, 64 * 1024);
+    /* Diagnostics are not buffered, so they stay in order with the panic messages */
+    stderr_writer = File__create_writer(stderr, 0);
+    atexit(File__flush_writers);
 }
@@ -6,7 +6,12 @@
 #include "Writer.h"
 
 extern Writer *stdout_writer;
-extern Writer *stderr_writer;
+/* Each thread has its own, so that worker tasks can collect their diagnostics */
+extern _Thread_local Writer *stderr_writer;
+
+Writer *File__create_writer(FILE *file, size_t buffer_size);
+
+Writer *File__create_fd_writer(int fd, size_t buffer_size);
 
 void File__init();
 
@@ -3,17 +3,30 @@
 #include "Generator.h"
 #include "CDECL.h"
 #include "File.h"
+#include "Worker.h"
+
+/* Definitions are generated by all workers only in batches of at least this many statements */
+#ifndef GENERATOR__BATCH_STATEMENTS
+#define GENERATOR__BATCH_STATEMENTS 1024
+#endif
 
 typedef struct Generator {
     Writer *writer;
     uint16_t identation;
+    /* The source whose symbols are generated, or NULL for the symbols of all sources */
+    Source *source;
 } Generator;
 
-void Generator__write_source_location(Generator *self, Source_Location *location) {
+bool Generator__is_generated(Generator *self, Source_Location location) {
+    Source *source = Source_Location__get_source(location);
+    return self->source != NULL ? source == self->source : source != NULL;
+}
+
+void Generator__write_source_location(Generator *self, Source_Location location) {
     pWriter__write__cstring(self->writer, "#line ");
-    pWriter__write__int64(self->writer, (int64_t)location->line);
+    pWriter__write__uint64(self->writer, Source_Location__get_line(location));
     pWriter__write__cstring(self->writer, " \"");
-    pWriter__write__string(self->writer, location->source->file_path);
+    pWriter__write__string(self->writer, Source_Location__get_source(location)->file_path);
     pWriter__write__cstring(self->writer, "\"\n");
 }
 
@@ -450,8 +463,8 @@ void Generator__generate_statement(Generator *self, Checked_Statement *statement
 void Generator__generate_statements(Generator *self, Checked_Statements *statements) {
     self->identation = self->identation + 1;
 
-    Checked_Statement *statement = statements->first_statement;
-    while (statement != NULL) {
+    for (uint32_t statement_index = 0; statement_index < statements->statements_count; statement_index++) {
+        Checked_Statement *statement = statements->statements[statement_index];
         Generator__write_source_location(self, statement->location);
 
         Generator__write_identation(self);
@@ -459,8 +472,6 @@ void Generator__generate_statements(Generator *self, Checked_Statements *stateme
         Generator__generate_statement(self, statement);
 
         pWriter__write__cstring(self->writer, "\n");
-
-        statement = statement->next_statement;
     }
 
     self->identation = self->identation - 1;
@@ -496,17 +507,16 @@ void Generator__declare_struct(Generator *self, Checked_Struct_Type *struct_type
 }
 
 void Generator__generate_struct(Generator *self, Checked_Struct_Type *struct_type) {
-    Checked_Struct_Member *struct_member = struct_type->first_member;
-    if (struct_member == NULL) {
+    if (struct_type->members_count == 0) {
         return;
     }
     pWriter__write__cdecl(self->writer, NULL, (Checked_Type *)struct_type);
     pWriter__write__cstring(self->writer, " {\n");
-    while (struct_member != NULL) {
+    for (size_t index = 0; index < struct_type->members_count; index++) {
+        Checked_Struct_Member *struct_member = &struct_type->members[index];
         pWriter__write__cstring(self->writer, "    ");
         pWriter__write__cdecl(self->writer, struct_member->name, struct_member->type);
         pWriter__write__cstring(self->writer, ";\n");
-        struct_member = struct_member->next_member;
     }
     pWriter__write__cstring(self->writer, "};\n\n");
 }
@@ -547,54 +557,129 @@ void Generator__generate_trait(Generator *self, Checked_Trait_Type *trait_type)
     Generator__generate_struct(self, trait_type->struct_type);
 }
 
-void generate(Writer *writer, Checked_Source *checked_source) {
-    Generator generator;
-    generator.writer = writer;
-    generator.identation = 0;
+void Generator__generate_definition(Generator *self, Checked_Symbol *checked_symbol) {
+    if (checked_symbol->kind == CHECKED_SYMBOL_KIND__FUNCTION) {
+        Generator__generate_function(self, (Checked_Function_Symbol *)checked_symbol);
+    } else {
+        Checked_Named_Type *named_type = ((Checked_Type_Symbol *)checked_symbol)->named_type;
+        if (named_type->super.kind == CHECKED_TYPE_KIND__STRUCT) {
+            Generator__generate_make_struct_function(self, (Checked_Struct_Type *)named_type);
+        } else if (named_type->super.kind == CHECKED_TYPE_KIND__TRAIT) {
+            Generator__generate_make_struct_function(self, ((Checked_Trait_Type *)named_type)->struct_type);
+        }
+    }
+}
 
-    Checked_Symbol *checked_symbol;
+typedef struct Generator_Definitions_Task {
+    Checked_Symbol **symbols;
+    size_t symbols_count;
+    String *output;
+    Writer *writer;
+} Generator_Definitions_Task;
 
-    pWriter__write__cstring(generator.writer, "#include <inttypes.h>");
-    pWriter__end_line(generator.writer);
-    pWriter__write__cstring(generator.writer, "#include <stdbool.h>");
-    pWriter__end_line(generator.writer);
-    pWriter__write__cstring(generator.writer, "#include <stddef.h>");
-    pWriter__end_line(generator.writer);
-    pWriter__end_line(generator.writer);
+static void Generator_Definitions_Task__generate(Generator_Definitions_Task *self) {
+    Generator generator = {.writer = self->writer, .identation = 0};
+    for (size_t index = 0; index < self->symbols_count; index++) {
+        Generator__generate_definition(&generator, self->symbols[index]);
+    }
+}
 
-    Source *source = checked_source->first_source->next;
-    while (source != NULL) {
-        if (source->file_path->data[source->file_path->length - 1] == 'h') {
-            pWriter__write__cstring(generator.writer, "#include \"");
-            pWriter__write__string(generator.writer, source->file_path);
-            pWriter__write__char(generator.writer, '"');
-            pWriter__end_line(generator.writer);
-            pWriter__end_line(generator.writer);
+/*
+ * The definitions are generated independently. So they are generated by all workers, in
+ * batches of consecutive definitions, each batch into its own buffer, and the buffers are
+ * written in order, which gives the same output as generating them one after another. Function
+ * bodies are measured by their top level statements, so that small programs don't pay for the
+ * threads.
+ */
+static void Generator__generate_definitions(Generator *self, Checked_Symbol **symbols, size_t symbols_count) {
+    size_t statements_count = 0;
+    for (size_t index = 0; index < symbols_count; index++) {
+        Checked_Statements *statements = symbols[index]->kind == CHECKED_SYMBOL_KIND__FUNCTION ? ((Checked_Function_Symbol *)symbols[index])->checked_statements : NULL;
+        statements_count = statements_count + (statements != NULL ? statements->statements_count : 1);
+    }
+    size_t tasks_count = Workers__count() * 4 < symbols_count ? Workers__count() * 4 : symbols_count;
+    if (statements_count / GENERATOR__BATCH_STATEMENTS < tasks_count) {
+        tasks_count = statements_count / GENERATOR__BATCH_STATEMENTS;
+    }
+    if (Workers__count() == 1 || tasks_count < 2) {
+        for (size_t index = 0; index < symbols_count; index++) {
+            Generator__generate_definition(self, symbols[index]);
         }
-        source = source->next;
+        return;
+    }
+
+    Generator_Definitions_Task *definitions_tasks = (Generator_Definitions_Task *)malloc(tasks_count * sizeof(Generator_Definitions_Task));
+    Worker_Task *tasks = (Worker_Task *)malloc(tasks_count * sizeof(Worker_Task));
+    size_t symbols_index = 0;
+    for (size_t task_index = 0; task_index < tasks_count; task_index++) {
+        size_t next_symbols_index = symbols_count * (task_index + 1) / tasks_count;
+        Generator_Definitions_Task *definitions_task = &definitions_tasks[task_index];
+        definitions_task->symbols = symbols + symbols_index;
+        definitions_task->symbols_count = next_symbols_index - symbols_index;
+        definitions_task->output = String__create();
+        definitions_task->writer = String__create_writer(definitions_task->output);
+        tasks[task_index] = (Worker_Task){.run = (void (*)(void *))Generator_Definitions_Task__generate, .data = definitions_task};
+        symbols_index = next_symbols_index;
     }
+    Workers__run(tasks, tasks_count);
+    bool has_failed = false;
+    for (size_t task_index = 0; task_index < tasks_count; task_index++) {
+        Generator_Definitions_Task *definitions_task = &definitions_tasks[task_index];
+        pWriter__destroy(definitions_task->writer);
+        /* The output is written up to the first failed task, as when generating in order */
+        if (!has_failed) {
+            pWriter__write__string(self->writer, definitions_task->output);
+            has_failed = tasks[task_index].has_failed;
+        }
+        String__delete(definitions_task->output);
+    }
+    Workers__report(tasks, tasks_count);
+    free(tasks);
+    free(definitions_tasks);
+}
+
+void Generator__generate_includes(Generator *self) {
+    pWriter__write__cstring(self->writer, "#include <inttypes.h>");
+    pWriter__end_line(self->writer);
+    pWriter__write__cstring(self->writer, "#include <stdbool.h>");
+    pWriter__end_line(self->writer);
+    pWriter__write__cstring(self->writer, "#include <stddef.h>");
+    pWriter__end_line(self->writer);
+    pWriter__end_line(self->writer);
+}
 
+Checked_Function_Symbol *Generator__find_malloc_function(Checked_Source *checked_source) {
     Checked_Function_Symbol *malloc_function = NULL;
+    Checked_Symbol *checked_symbol = checked_source->first_symbol;
+    while (checked_symbol != NULL) {
+        if (checked_symbol->kind == CHECKED_SYMBOL_KIND__FUNCTION && String__equals_cstring(checked_symbol->name, "malloc")) {
+            malloc_function = (Checked_Function_Symbol *)checked_symbol;
+        }
+        checked_symbol = checked_symbol->next_symbol;
+    }
+    return malloc_function;
+}
+
+void Generator__generate_types(Generator *self, Checked_Source *checked_source) {
+    Checked_Symbol *checked_symbol;
 
     /* Declare all defined types */
     checked_symbol = checked_source->first_symbol;
     while (checked_symbol != NULL) {
-        if (checked_symbol->kind == CHECKED_SYMBOL_KIND__TYPE && checked_symbol->location != NULL && checked_symbol->location->source == checked_source->first_source) {
+        if (checked_symbol->kind == CHECKED_SYMBOL_KIND__TYPE && Generator__is_generated(self, checked_symbol->location)) {
             Checked_Named_Type *named_type = ((Checked_Type_Symbol *)checked_symbol)->named_type;
             switch (named_type->super.kind) {
             case CHECKED_TYPE_KIND__EXTERNAL:
-                Generator__declare_external_type(&generator, (Checked_External_Type *)named_type);
+                Generator__declare_external_type(self, (Checked_External_Type *)named_type);
                 break;
             case CHECKED_TYPE_KIND__STRUCT:
-                Generator__declare_struct(&generator, (Checked_Struct_Type *)named_type);
+                Generator__declare_struct(self, (Checked_Struct_Type *)named_type);
                 break;
             case CHECKED_TYPE_KIND__TRAIT:
-                Generator__declare_trait(&generator, (Checked_Trait_Type *)named_type);
+                Generator__declare_trait(self, (Checked_Trait_Type *)named_type);
                 break;
             }
-            pWriter__end_line(generator.writer);
-        } else if (checked_symbol->kind == CHECKED_SYMBOL_KIND__FUNCTION && String__equals_cstring(checked_symbol->name, "malloc")) {
-            malloc_function = (Checked_Function_Symbol *)checked_symbol;
+            pWriter__end_line(self->writer);
         }
         checked_symbol = checked_symbol->next_symbol;
     }
@@ -602,71 +687,158 @@ void generate(Writer *writer, Checked_Source *checked_source) {
     /* Generate all defined types */
     checked_symbol = checked_source->first_symbol;
     while (checked_symbol != NULL) {
-        if (checked_symbol->kind == CHECKED_SYMBOL_KIND__TYPE && checked_symbol->location != NULL && checked_symbol->location->source == checked_source->first_source) {
+        if (checked_symbol->kind == CHECKED_SYMBOL_KIND__TYPE && Generator__is_generated(self, checked_symbol->location)) {
             Checked_Named_Type *named_type = ((Checked_Type_Symbol *)checked_symbol)->named_type;
             switch (named_type->super.kind) {
             case CHECKED_TYPE_KIND__STRUCT:
-                Generator__generate_struct(&generator, (Checked_Struct_Type *)named_type);
+                Generator__generate_struct(self, (Checked_Struct_Type *)named_type);
                 break;
             case CHECKED_TYPE_KIND__TRAIT:
-                Generator__generate_trait(&generator, (Checked_Trait_Type *)named_type);
+                Generator__generate_trait(self, (Checked_Trait_Type *)named_type);
                 break;
             }
         }
         checked_symbol = checked_symbol->next_symbol;
     }
+}
 
-    /* Declare all global variables */
-    Checked_Statement *checked_statement = checked_source->statements->first_statement;
-    while (checked_statement != NULL) {
-        if (checked_statement->kind == CHECKED_STATEMENT_KIND__VARIABLE && checked_statement->location != NULL && checked_statement->location->source == checked_source->first_source) {
-            Generator__generate_variable_statement(&generator, (Checked_Variable_Statement *)checked_statement);
-            pWriter__end_line(generator.writer);
-        } else {
+/* Module variables are defined by their module, and declared by the module header */
+void Generator__generate_module_variables(Generator *self, Checked_Source *checked_source, bool is_declaration) {
+    for (uint32_t statement_index = 0; statement_index < checked_source->statements->statements_count; statement_index++) {
+        Checked_Statement *checked_statement = checked_source->statements->statements[statement_index];
+        if (checked_statement->kind != CHECKED_STATEMENT_KIND__VARIABLE) {
             pWriter__begin_location_message(stderr_writer, checked_statement->location, WRITER_STYLE__ERROR);
             pWriter__write__cstring(stderr_writer, "Unsupported statement");
             pWriter__end_location_message(stderr_writer);
             panic();
         }
-        checked_statement = checked_statement->next_statement;
+        if (Generator__is_generated(self, checked_statement->location)) {
+            Checked_Variable_Statement *variable_statement = (Checked_Variable_Statement *)checked_statement;
+            if (is_declaration) {
+                pWriter__write__cstring(self->writer, "extern ");
+                pWriter__write__cdecl(self->writer, variable_statement->variable->super.name, variable_statement->variable->super.type);
+                pWriter__write__cstring(self->writer, ";");
+                pWriter__end_line(self->writer);
+            } else if (!variable_statement->is_external) {
+                Generator__generate_variable_statement(self, variable_statement);
+                pWriter__end_line(self->writer);
+            }
+        }
     }
+}
 
-    /* Declare all defined functions */
-    checked_symbol = checked_source->first_symbol;
+void Generator__declare_functions(Generator *self, Checked_Source *checked_source, Checked_Function_Symbol *malloc_function) {
+    Checked_Symbol *checked_symbol = checked_source->first_symbol;
     while (checked_symbol != NULL) {
-        if (checked_symbol->location != NULL && checked_symbol->location->source == checked_source->first_source) {
+        if (Generator__is_generated(self, checked_symbol->location)) {
             if (checked_symbol->kind == CHECKED_SYMBOL_KIND__FUNCTION) {
-                Generator__declare_function(&generator, (Checked_Function_Symbol *)checked_symbol);
-                pWriter__end_line(generator.writer);
+                Generator__declare_function(self, (Checked_Function_Symbol *)checked_symbol);
+                pWriter__end_line(self->writer);
             } else if (checked_symbol->kind == CHECKED_SYMBOL_KIND__TYPE && malloc_function != NULL) {
                 Checked_Named_Type *named_type = ((Checked_Type_Symbol *)checked_symbol)->named_type;
                 if (named_type->super.kind == CHECKED_TYPE_KIND__STRUCT) {
-                    Generator__declare_make_struct_function(&generator, (Checked_Struct_Type *)named_type);
-                    pWriter__end_line(generator.writer);
+                    Generator__declare_make_struct_function(self, (Checked_Struct_Type *)named_type);
+                    pWriter__end_line(self->writer);
                 } else if (named_type->super.kind == CHECKED_TYPE_KIND__TRAIT) {
-                    Generator__declare_make_struct_function(&generator, ((Checked_Trait_Type *)named_type)->struct_type);
-                    pWriter__end_line(generator.writer);
+                    Generator__declare_make_struct_function(self, ((Checked_Trait_Type *)named_type)->struct_type);
+                    pWriter__end_line(self->writer);
                 }
             }
         }
         checked_symbol = checked_symbol->next_symbol;
     }
+}
 
-    /* Generate all defined functions */
-    checked_symbol = checked_source->first_symbol;
+void Generator__define_functions(Generator *self, Checked_Source *checked_source, Checked_Function_Symbol *malloc_function) {
+    size_t definitions_count = 0;
+    size_t definitions_size = 64;
+    Checked_Symbol **definitions = (Checked_Symbol **)malloc(definitions_size * sizeof(Checked_Symbol *));
+    Checked_Symbol *checked_symbol = checked_source->first_symbol;
     while (checked_symbol != NULL) {
-        if (checked_symbol->location != NULL && checked_symbol->location->source == checked_source->first_source) {
-            if (checked_symbol->kind == CHECKED_SYMBOL_KIND__FUNCTION) {
-                Generator__generate_function(&generator, (Checked_Function_Symbol *)checked_symbol);
-            } else if (checked_symbol->kind == CHECKED_SYMBOL_KIND__TYPE && malloc_function != NULL) {
-                Checked_Named_Type *named_type = ((Checked_Type_Symbol *)checked_symbol)->named_type;
-                if (named_type->super.kind == CHECKED_TYPE_KIND__STRUCT) {
-                    Generator__generate_make_struct_function(&generator, (Checked_Struct_Type *)named_type);
-                } else if (named_type->super.kind == CHECKED_TYPE_KIND__TRAIT) {
-                    Generator__generate_make_struct_function(&generator, ((Checked_Trait_Type *)named_type)->struct_type);
+        if (Generator__is_generated(self, checked_symbol->location)) {
+            if (checked_symbol->kind == CHECKED_SYMBOL_KIND__FUNCTION || (checked_symbol->kind == CHECKED_SYMBOL_KIND__TYPE && malloc_function != NULL)) {
+                if (definitions_count == definitions_size) {
+                    definitions_size = definitions_size * 2;
+                    definitions = (Checked_Symbol **)realloc(definitions, definitions_size * sizeof(Checked_Symbol *));
                 }
+                definitions[definitions_count] = checked_symbol;
+                definitions_count = definitions_count + 1;
             }
         }
         checked_symbol = checked_symbol->next_symbol;
     }
+    Generator__generate_definitions(self, definitions, definitions_count);
+    free(definitions);
+}
+
+void generate(Writer *writer, Checked_Source *checked_source) {
+    Generator generator = {.writer = writer, .identation = 0, .source = checked_source->first_source};
+
+    Generator__generate_includes(&generator);
+
+    Source *source = checked_source->first_source->next;
+    while (source != NULL) {
+        if (source->file_path->data[source->file_path->length - 1] == 'h') {
+            pWriter__write__cstring(generator.writer, "#include \"");
+            pWriter__write__string(generator.writer, source->file_path);
+            pWriter__write__char(generator.writer, '"');
+            pWriter__end_line(generator.writer);
+            pWriter__end_line(generator.writer);
+        }
+        source = source->next;
+    }
+
+    Checked_Function_Symbol *malloc_function = Generator__find_malloc_function(checked_source);
+
+    Generator__generate_types(&generator, checked_source);
+
+    /* Declare all global variables */
+    for (uint32_t statement_index = 0; statement_index < checked_source->statements->statements_count; statement_index++) {
+        Checked_Statement *checked_statement = checked_source->statements->statements[statement_index];
+        if (checked_statement->kind == CHECKED_STATEMENT_KIND__VARIABLE && Generator__is_generated(&generator, checked_statement->location)) {
+            Generator__generate_variable_statement(&generator, (Checked_Variable_Statement *)checked_statement);
+            pWriter__end_line(generator.writer);
+        } else {
+            pWriter__begin_location_message(stderr_writer, checked_statement->location, WRITER_STYLE__ERROR);
+            pWriter__write__cstring(stderr_writer, "Unsupported statement");
+            pWriter__end_location_message(stderr_writer);
+            panic();
+        }
+    }
+
+    /* Declare all defined functions */
+    Generator__declare_functions(&generator, checked_source, malloc_function);
+
+    /* Generate all defined functions */
+    Generator__define_functions(&generator, checked_source, malloc_function);
+}
+
+void generate_module_header(Writer *writer, Checked_Source *checked_source) {
+    Generator generator = {.writer = writer, .identation = 0, .source = NULL};
+
+    Generator__generate_includes(&generator);
+
+    Checked_Function_Symbol *malloc_function = Generator__find_malloc_function(checked_source);
+
+    Generator__generate_types(&generator, checked_source);
+
+    Generator__generate_module_variables(&generator, checked_source, true);
+
+    Generator__declare_functions(&generator, checked_source, malloc_function);
+}
+
+void generate_module(Writer *writer, Checked_Source *checked_source, Source *source, String *header_name) {
+    Generator generator = {.writer = writer, .identation = 0, .source = source};
+
+    pWriter__write__cstring(generator.writer, "#include \"");
+    pWriter__write__string(generator.writer, header_name);
+    pWriter__write__char(generator.writer, '"');
+    pWriter__end_line(generator.writer);
+    pWriter__end_line(generator.writer);
+
+    Checked_Function_Symbol *malloc_function = Generator__find_malloc_function(checked_source);
+
+    Generator__generate_module_variables(&generator, checked_source, false);
+
+    Generator__define_functions(&generator, checked_source, malloc_function);
 }
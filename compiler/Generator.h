@@ -7,4 +7,10 @@
 
 void generate(Writer *writer, Checked_Source *checked_source);
 
+/* Declares the types, variables and functions of all modules, for all their translation units */
+void generate_module_header(Writer *writer, Checked_Source *checked_source);
+
+/* Defines the variables and functions of one module, after including the module header */
+void generate_module(Writer *writer, Checked_Source *checked_source, Source *source, String *header_name);
+
 #endif
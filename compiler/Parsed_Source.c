@@ -1,15 +1,16 @@
 /* Copyright (C) 2024 Stefan Selariu */
 
 #include "Parsed_Source.h"
+#include "Arena.h"
 
-Parsed_Type *Parsed_Type__create_kind(Parsed_Type_Kind kind, size_t kind_size, Source_Location *location) {
-    Parsed_Type *type = (Parsed_Type *)malloc(kind_size);
+Parsed_Type *Parsed_Type__create_kind(Parsed_Type_Kind kind, size_t kind_size, Source_Location location) {
+    Parsed_Type *type = (Parsed_Type *)Arena__allocate(parse_arena, kind_size);
     type->kind = kind;
     type->location = location;
     return type;
 }
 
-Parsed_Array_Type *Parsed_Array_Type__create(Source_Location *location, Parsed_Type *item_type, bool is_checked, Parsed_Expression *size_expression) {
+Parsed_Array_Type *Parsed_Array_Type__create(Source_Location location, Parsed_Type *item_type, bool is_checked, Parsed_Expression *size_expression) {
     Parsed_Array_Type *type = (Parsed_Array_Type *)Parsed_Type__create_kind(PARSED_TYPE_KIND__ARRAY, sizeof(Parsed_Array_Type), location);
     type->item_type = item_type;
     type->is_checked = is_checked;
@@ -18,7 +19,7 @@ Parsed_Array_Type *Parsed_Array_Type__create(Source_Location *location, Parsed_T
 }
 
 Parsed_Function_Parameter *Parsed_Function_Parameter__create(Token *label, Token *name, Parsed_Type *type) {
-    Parsed_Function_Parameter *parameter = (Parsed_Function_Parameter *)malloc(sizeof(Parsed_Function_Parameter));
+    Parsed_Function_Parameter *parameter = (Parsed_Function_Parameter *)Arena__allocate(parse_arena, sizeof(Parsed_Function_Parameter));
     parameter->label = label;
     parameter->name = name;
     parameter->type = type;
@@ -26,7 +27,7 @@ Parsed_Function_Parameter *Parsed_Function_Parameter__create(Token *label, Token
     return parameter;
 }
 
-Parsed_Type *Parsed_Function_Type__create(Source_Location *location, Parsed_Function_Parameter *first_parameter, Parsed_Type *return_type) {
+Parsed_Type *Parsed_Function_Type__create(Source_Location location, Parsed_Function_Parameter *first_parameter, Parsed_Type *return_type) {
     Parsed_Function_Type *type = (Parsed_Function_Type *)Parsed_Type__create_kind(PARSED_TYPE_KIND__FUNCTION, sizeof(Parsed_Function_Type), location);
     type->first_parameter = first_parameter;
     type->return_type = return_type;
@@ -45,12 +46,12 @@ Parsed_Type *Parsed_Pointer_Type__create(Parsed_Type *other_type) {
     return (Parsed_Type *)type;
 }
 
-Parsed_Receiver_Type *Parsed_Receiver_Type__create(Source_Location *location) {
+Parsed_Receiver_Type *Parsed_Receiver_Type__create(Source_Location location) {
     return (Parsed_Receiver_Type *)Parsed_Type__create_kind(PARSED_TYPE_KIND__RECEIVER, sizeof(Parsed_Receiver_Type), location);
 }
 
-Parsed_Expression *Parsed_Expression__create_kind(Parsed_Expression_Kind kind, size_t kind_size, Source_Location *location) {
-    Parsed_Expression *expression = (Parsed_Expression *)malloc(kind_size);
+Parsed_Expression *Parsed_Expression__create_kind(Parsed_Expression_Kind kind, size_t kind_size, Source_Location location) {
+    Parsed_Expression *expression = (Parsed_Expression *)Arena__allocate(parse_arena, kind_size);
     expression->kind = kind;
     expression->location = location;
     return expression;
@@ -63,7 +64,7 @@ Parsed_Binary_Expression *Parsed_Binary_Expression__create_kind(Parsed_Expressio
     return expression;
 }
 
-Parsed_Unary_Expression *Parsed_Unary_Expression__create_kind(Parsed_Expression_Kind kind, size_t kind_size, Source_Location *location, Parsed_Expression *other_expression) {
+Parsed_Unary_Expression *Parsed_Unary_Expression__create_kind(Parsed_Expression_Kind kind, size_t kind_size, Source_Location location, Parsed_Expression *other_expression) {
     Parsed_Unary_Expression *expression = (Parsed_Unary_Expression *)Parsed_Expression__create_kind(kind, kind_size, location);
     expression->other_expression = other_expression;
     return expression;
@@ -79,7 +80,7 @@ Parsed_Add_Expression *Parsed_Add_Expression__create(Parsed_Expression *left_exp
     return (Parsed_Add_Expression *)Parsed_Binary_Expression__create_kind(PARSED_EXPRESSION_KIND__ADD, left_expression, right_expression);
 }
 
-Parsed_Address_Of_Expression *Parsed_Address_Of_Expression__create(Source_Location *location, Parsed_Expression *other_expression) {
+Parsed_Address_Of_Expression *Parsed_Address_Of_Expression__create(Source_Location location, Parsed_Expression *other_expression) {
     return (Parsed_Address_Of_Expression *)Parsed_Unary_Expression__create_kind(PARSED_EXPRESSION_KIND__ADDRESS_OF, sizeof(Parsed_Address_Of_Expression), location, other_expression);
 }
 
@@ -96,8 +97,8 @@ Parsed_Bool_Expression *Parsed_Bool_Expression__create(Token *literal, bool valu
     return expression;
 }
 
-Parsed_Call_Argument *Parsed_Call_Argument__create(Source_Location *location, Identifier_Token *name, Parsed_Expression *expression) {
-    Parsed_Call_Argument *argument = (Parsed_Call_Argument *)malloc(sizeof(Parsed_Call_Argument));
+Parsed_Call_Argument *Parsed_Call_Argument__create(Source_Location location, Token *name, Parsed_Expression *expression) {
+    Parsed_Call_Argument *argument = (Parsed_Call_Argument *)Arena__allocate(parse_arena, sizeof(Parsed_Call_Argument));
     argument->location = location;
     argument->name = name;
     argument->expression = expression;
@@ -112,19 +113,19 @@ Parsed_Call_Expression *Parsed_Call_Expression__create(Parsed_Expression *callee
     return expression;
 }
 
-Parsed_Cast_Expression *Parsed_Cast_Expression__create(Source_Location *location, Parsed_Expression *other_expression, Parsed_Type *type) {
+Parsed_Cast_Expression *Parsed_Cast_Expression__create(Source_Location location, Parsed_Expression *other_expression, Parsed_Type *type) {
     Parsed_Cast_Expression *expression = (Parsed_Cast_Expression *)Parsed_Unary_Expression__create_kind(PARSED_EXPRESSION_KIND__CAST, sizeof(Parsed_Cast_Expression), location, other_expression);
     expression->type = type;
     return expression;
 }
 
-Parsed_Character_Expression *Parsed_Character_Expression__create(Character_Token *literal) {
-    Parsed_Character_Expression *expression = (Parsed_Character_Expression *)Parsed_Literal_Expression__create_kind(PARSED_EXPRESSION_KIND__CHARACTER, sizeof(Parsed_Character_Expression), (Token *)literal);
-    expression->value = literal->value;
+Parsed_Character_Expression *Parsed_Character_Expression__create(Token *literal) {
+    Parsed_Character_Expression *expression = (Parsed_Character_Expression *)Parsed_Literal_Expression__create_kind(PARSED_EXPRESSION_KIND__CHARACTER, sizeof(Parsed_Character_Expression), literal);
+    expression->value = literal->character_value;
     return expression;
 }
 
-Parsed_Dereference_Expression *Parsed_Dereference_Expression__create(Source_Location *location, Parsed_Expression *other_expression) {
+Parsed_Dereference_Expression *Parsed_Dereference_Expression__create(Source_Location location, Parsed_Expression *other_expression) {
     return (Parsed_Dereference_Expression *)Parsed_Unary_Expression__create_kind(PARSED_EXPRESSION_KIND__DEREFERENCE, sizeof(Parsed_Dereference_Expression), location, other_expression);
 }
 
@@ -144,15 +145,15 @@ Parsed_Greater_Or_Equals_Expression *Parsed_Greater_Or_Equals_Expression__create
     return (Parsed_Greater_Or_Equals_Expression *)Parsed_Binary_Expression__create_kind(PARSED_EXPRESSION_KIND__GREATER_OR_EQUALS, left_expression, right_expression);
 }
 
-Parsed_Group_Expression *Parsed_Group_Expression__create(Source_Location *location, Parsed_Expression *other_expression) {
+Parsed_Group_Expression *Parsed_Group_Expression__create(Source_Location location, Parsed_Expression *other_expression) {
     Parsed_Group_Expression *expression = (Parsed_Group_Expression *)Parsed_Expression__create_kind(PARSED_EXPRESSION_KIND__GROUP, sizeof(Parsed_Group_Expression), location);
     expression->other_expression = other_expression;
     return expression;
 }
 
-Parsed_Integer_Expression *Parsed_Integer_Expression__create(Integer_Token *literal, Parsed_Named_Type *type) {
-    Parsed_Integer_Expression *expression = (Parsed_Integer_Expression *)Parsed_Literal_Expression__create_kind(PARSED_EXPRESSION_KIND__INTEGER, sizeof(Parsed_Integer_Expression), (Token *)literal);
-    expression->value = literal->value;
+Parsed_Integer_Expression *Parsed_Integer_Expression__create(Token *literal, Parsed_Named_Type *type) {
+    Parsed_Integer_Expression *expression = (Parsed_Integer_Expression *)Parsed_Literal_Expression__create_kind(PARSED_EXPRESSION_KIND__INTEGER, sizeof(Parsed_Integer_Expression), literal);
+    expression->value = literal->integer_value;
     expression->type = type;
     return expression;
 }
@@ -173,7 +174,7 @@ Parsed_Logic_Or_Expression *Parsed_Logic_Or_Expression__create(Parsed_Expression
     return (Parsed_Logic_Or_Expression *)Parsed_Binary_Expression__create_kind(PARSED_EXPRESSION_KIND__LOGIC_OR, left_expression, right_expression);
 }
 
-Parsed_Make_Expression *Parsed_Make_Expression__create(Source_Location *location, Parsed_Type *type, Parsed_Call_Argument *first_argument) {
+Parsed_Make_Expression *Parsed_Make_Expression__create(Source_Location location, Parsed_Type *type, Parsed_Call_Argument *first_argument) {
     Parsed_Make_Expression *expression = (Parsed_Make_Expression *)Parsed_Expression__create_kind(PARSED_EXPRESSION_KIND__MAKE, sizeof(Parsed_Make_Expression), location);
     expression->type = type;
     expression->first_argument = first_argument;
@@ -187,7 +188,7 @@ Parsed_Member_Access_Expression *Parsed_Member_Access_Expression__create(Parsed_
     return expression;
 }
 
-Parsed_Minus_Expression *Parsed_Minus_Expression__create(Source_Location *location, Parsed_Expression *other_expression) {
+Parsed_Minus_Expression *Parsed_Minus_Expression__create(Source_Location location, Parsed_Expression *other_expression) {
     return (Parsed_Minus_Expression *)Parsed_Unary_Expression__create_kind(PARSED_EXPRESSION_KIND__MINUS, sizeof(Parsed_Minus_Expression), location, other_expression);
 }
 
@@ -199,7 +200,7 @@ Parsed_Multiply_Expression *Parsed_Multiply_Expression__create(Parsed_Expression
     return (Parsed_Multiply_Expression *)Parsed_Binary_Expression__create_kind(PARSED_EXPRESSION_KIND__MULTIPLY, left_expression, right_expression);
 }
 
-Parsed_Not_Expression *Parsed_Not_Expression__create(Source_Location *location, Parsed_Expression *other_expression) {
+Parsed_Not_Expression *Parsed_Not_Expression__create(Source_Location location, Parsed_Expression *other_expression) {
     return (Parsed_Not_Expression *)Parsed_Unary_Expression__create_kind(PARSED_EXPRESSION_KIND__NOT, sizeof(Parsed_Not_Expression), location, other_expression);
 }
 
@@ -211,15 +212,15 @@ Parsed_Null_Expression *Parsed_Null_Expression__create(Token *literal) {
     return (Parsed_Null_Expression *)Parsed_Literal_Expression__create_kind(PARSED_EXPRESSION_KIND__NULL, sizeof(Parsed_Null_Expression), literal);
 }
 
-Parsed_Sizeof_Expression *Parsed_Sizeof_Expression__create(Source_Location *location, Parsed_Type *type) {
+Parsed_Sizeof_Expression *Parsed_Sizeof_Expression__create(Source_Location location, Parsed_Type *type) {
     Parsed_Sizeof_Expression *expression = (Parsed_Sizeof_Expression *)Parsed_Expression__create_kind(PARSED_EXPRESSION_KIND__SIZEOF, sizeof(Parsed_Sizeof_Expression), location);
     expression->type = type;
     return expression;
 }
 
-Parsed_String_Expression *Parsed_String_Expression__create(String_Token *literal) {
-    Parsed_String_Expression *expression = (Parsed_String_Expression *)Parsed_Literal_Expression__create_kind(PARSED_EXPRESSION_KIND__STRING, sizeof(Parsed_String_Expression), (Token *)literal);
-    expression->value = literal->value;
+Parsed_String_Expression *Parsed_String_Expression__create(Token *literal) {
+    Parsed_String_Expression *expression = (Parsed_String_Expression *)Parsed_Literal_Expression__create_kind(PARSED_EXPRESSION_KIND__STRING, sizeof(Parsed_String_Expression), literal);
+    expression->value = Token__create_string_value(literal);
     return expression;
 }
 
@@ -233,15 +234,14 @@ Parsed_Symbol_Expression *Parsed_Symbol_Expression__create(Token *name) {
     return expression;
 }
 
-Parsed_Statement *Parsed_Statement__create_kind(Parsed_Statement_Kind kind, size_t kind_size, Source_Location *location) {
-    Parsed_Statement *statement = (Parsed_Statement *)malloc(kind_size);
+Parsed_Statement *Parsed_Statement__create_kind(Parsed_Statement_Kind kind, size_t kind_size, Source_Location location) {
+    Parsed_Statement *statement = (Parsed_Statement *)Arena__allocate(parse_arena, kind_size);
     statement->kind = kind;
     statement->location = location;
-    statement->next_statement = NULL;
     return statement;
 }
 
-Parsed_Named_Statement *Parsed_Named_Statement__create_kind(Parsed_Statement_Kind kind, size_t kind_size, Source_Location *location, Token *name) {
+Parsed_Named_Statement *Parsed_Named_Statement__create_kind(Parsed_Statement_Kind kind, size_t kind_size, Source_Location location, Token *name) {
     Parsed_Named_Statement *statement = (Parsed_Named_Statement *)Parsed_Statement__create_kind(kind, kind_size, location);
     statement->name = name;
     return statement;
@@ -254,13 +254,13 @@ Parsed_Assignment_Statement *Parsed_Assignment_Statement__create(Parsed_Expressi
     return statement;
 }
 
-Parsed_Block_Statement *Parsed_Block_Statement__create(Source_Location *location, Parsed_Statements *statements) {
+Parsed_Block_Statement *Parsed_Block_Statement__create(Source_Location location, Parsed_Statements *statements) {
     Parsed_Block_Statement *statement = (Parsed_Block_Statement *)Parsed_Statement__create_kind(PARSED_STATEMENT_KIND__BLOCK, sizeof(Parsed_Block_Statement), location);
     statement->statements = statements;
     return statement;
 }
 
-Parsed_Statement *Parsed_Break_Statement__create(Source_Location *location) {
+Parsed_Statement *Parsed_Break_Statement__create(Source_Location location) {
     return Parsed_Statement__create_kind(PARSED_STATEMENT_KIND__BREAK, sizeof(Parsed_Break_Statement), location);
 }
 
@@ -270,11 +270,11 @@ Parsed_Expression_Statement *Parsed_Expression_Statement__create(Parsed_Expressi
     return statement;
 }
 
-Parsed_External_Type_Statement *Parsed_External_Type_Statement__create(Source_Location *location, Token *name) {
+Parsed_External_Type_Statement *Parsed_External_Type_Statement__create(Source_Location location, Token *name) {
     return (Parsed_External_Type_Statement *)Parsed_Named_Statement__create_kind(PARSED_STATEMENT_KIND__EXTERNAL_TYPE, sizeof(Parsed_External_Type_Statement), location, name);
 }
 
-Parsed_Statement *Parsed_Function_Statement__create(Source_Location *location, Token *name, Parsed_Type *receiver_type, Parsed_Function_Parameter *first_parameter, Parsed_Type *resturn_type, Parsed_Statements *statements, bool is_external) {
+Parsed_Statement *Parsed_Function_Statement__create(Source_Location location, Token *name, Parsed_Type *receiver_type, Parsed_Function_Parameter *first_parameter, Parsed_Type *resturn_type, Parsed_Statements *statements, bool is_external) {
     Parsed_Function_Statement *statement = (Parsed_Function_Statement *)Parsed_Named_Statement__create_kind(PARSED_STATEMENT_KIND__FUNCTION, sizeof(Parsed_Function_Statement), location, name);
     statement->receiver_type = receiver_type;
     statement->first_parameter = first_parameter;
@@ -284,7 +284,7 @@ Parsed_Statement *Parsed_Function_Statement__create(Source_Location *location, T
     return (Parsed_Statement *)statement;
 }
 
-Parsed_Statement *Parsed_If_Statement__create(Source_Location *location, Parsed_Expression *condition_expression, Parsed_Statement *true_statement, Parsed_Statement *false_statement) {
+Parsed_Statement *Parsed_If_Statement__create(Source_Location location, Parsed_Expression *condition_expression, Parsed_Statement *true_statement, Parsed_Statement *false_statement) {
     Parsed_If_Statement *statement = (Parsed_If_Statement *)Parsed_Statement__create_kind(PARSED_STATEMENT_KIND__IF, sizeof(Parsed_If_Statement), location);
     statement->condition_expression = condition_expression;
     statement->true_statement = true_statement;
@@ -292,20 +292,20 @@ Parsed_Statement *Parsed_If_Statement__create(Source_Location *location, Parsed_
     return (Parsed_Statement *)statement;
 }
 
-Parsed_Statement *Parsed_Loop_Statement__create(Source_Location *location, Parsed_Statement *body_statement) {
+Parsed_Statement *Parsed_Loop_Statement__create(Source_Location location, Parsed_Statement *body_statement) {
     Parsed_Loop_Statement *statement = (Parsed_Loop_Statement *)Parsed_Statement__create_kind(PARSED_STATEMENT_KIND__LOOP, sizeof(Parsed_Loop_Statement), location);
     statement->body_statement = body_statement;
     return (Parsed_Statement *)statement;
 }
 
-Parsed_Statement *Parsed_Return_Statement__create(Source_Location *location, Parsed_Expression *expression) {
+Parsed_Statement *Parsed_Return_Statement__create(Source_Location location, Parsed_Expression *expression) {
     Parsed_Return_Statement *statement = (Parsed_Return_Statement *)Parsed_Statement__create_kind(PARSED_STATEMENT_KIND__RETURN, sizeof(Parsed_Return_Statement), location);
     statement->expression = expression;
     return (Parsed_Statement *)statement;
 }
 
 Parsed_Struct_Member *Parsed_Struct_Member__create(Token *name, Parsed_Type *type) {
-    Parsed_Struct_Member *member = (Parsed_Struct_Member *)malloc(sizeof(Parsed_Struct_Member));
+    Parsed_Struct_Member *member = (Parsed_Struct_Member *)Arena__allocate(parse_arena, sizeof(Parsed_Struct_Member));
     member->name = name;
     member->type = type;
     member->next_member = NULL;
@@ -313,21 +313,21 @@ Parsed_Struct_Member *Parsed_Struct_Member__create(Token *name, Parsed_Type *typ
 }
 
 Parsed_Struct_Method *Parsed_Struct_Method__create(Parsed_Function_Statement *function_statement) {
-    Parsed_Struct_Method *method = (Parsed_Struct_Method *)malloc(sizeof(Parsed_Struct_Method));
+    Parsed_Struct_Method *method = (Parsed_Struct_Method *)Arena__allocate(parse_arena, sizeof(Parsed_Struct_Method));
     method->function_statement = function_statement;
     method->next_method = NULL;
     return method;
 }
 
-Parsed_Struct_Statement *Parsed_Struct_Statement__create(Source_Location *location, Token *name) {
+Parsed_Struct_Statement *Parsed_Struct_Statement__create(Source_Location location, Token *name) {
     Parsed_Struct_Statement *statement = (Parsed_Struct_Statement *)Parsed_Named_Statement__create_kind(PARSED_STATEMENT_KIND__STRUCT, sizeof(Parsed_Struct_Statement), location, name);
     statement->first_member = NULL;
     statement->first_method = NULL;
     return statement;
 }
 
-Parsed_Trait_Method *Parsed_Trait_Method__create(Source_Location *location, Token *name, Parsed_Function_Parameter *first_parameter, Parsed_Type *return_type) {
-    Parsed_Trait_Method *method = (Parsed_Trait_Method *)malloc(sizeof(Parsed_Trait_Method));
+Parsed_Trait_Method *Parsed_Trait_Method__create(Source_Location location, Token *name, Parsed_Function_Parameter *first_parameter, Parsed_Type *return_type) {
+    Parsed_Trait_Method *method = (Parsed_Trait_Method *)Arena__allocate(parse_arena, sizeof(Parsed_Trait_Method));
     method->location = location;
     method->name = name;
     method->first_parameter = first_parameter;
@@ -336,13 +336,13 @@ Parsed_Trait_Method *Parsed_Trait_Method__create(Source_Location *location, Toke
     return method;
 }
 
-Parsed_Trait_Statement *Parsed_Trait_Statement__create(Source_Location *location, Token *name) {
+Parsed_Trait_Statement *Parsed_Trait_Statement__create(Source_Location location, Token *name) {
     Parsed_Trait_Statement *statement = (Parsed_Trait_Statement *)Parsed_Named_Statement__create_kind(PARSED_STATEMENT_KIND__TRAIT, sizeof(Parsed_Trait_Statement), location, name);
     statement->first_method = NULL;
     return statement;
 }
 
-Parsed_Variable_Statement *Parsed_Variable_Statement__create(Source_Location *location, Token *name, Parsed_Type *type, Parsed_Expression *expression, bool is_external) {
+Parsed_Variable_Statement *Parsed_Variable_Statement__create(Source_Location location, Token *name, Parsed_Type *type, Parsed_Expression *expression, bool is_external) {
     Parsed_Variable_Statement *statement = (Parsed_Variable_Statement *)Parsed_Named_Statement__create_kind(PARSED_STATEMENT_KIND__VARIABLE, sizeof(Parsed_Variable_Statement), location, name);
     statement->type = type;
     statement->expression = expression;
@@ -350,7 +350,7 @@ Parsed_Variable_Statement *Parsed_Variable_Statement__create(Source_Location *lo
     return statement;
 }
 
-Parsed_Statement *Parsed_While_Statement__create(Source_Location *location, Parsed_Expression *condition_expression, Parsed_Statement *body_statement) {
+Parsed_Statement *Parsed_While_Statement__create(Source_Location location, Parsed_Expression *condition_expression, Parsed_Statement *body_statement) {
     Parsed_While_Statement *statement = (Parsed_While_Statement *)Parsed_Statement__create_kind(PARSED_STATEMENT_KIND__WHILE, sizeof(Parsed_While_Statement), location);
     statement->condition_expression = condition_expression;
     statement->body_statement = body_statement;
@@ -358,24 +358,30 @@ Parsed_Statement *Parsed_While_Statement__create(Source_Location *location, Pars
 }
 
 Parsed_Statements *Parsed_Statements__create(bool has_globals) {
-    Parsed_Statements *statements = (Parsed_Statements *)malloc(sizeof(Parsed_Statements));
-    statements->first_statement = NULL;
-    statements->last_statement = NULL;
+    Parsed_Statements *statements = (Parsed_Statements *)Arena__allocate(parse_arena, sizeof(Parsed_Statements));
+    statements->statements = NULL;
+    statements->statements_count = 0;
+    statements->statements_size = 0;
     statements->has_globals = has_globals;
     return statements;
 }
 
 void Parsed_Statements__append(Parsed_Statements *self, Parsed_Statement *statement) {
-    if (self->first_statement == NULL) {
-        self->first_statement = statement;
-    } else {
-        self->last_statement->next_statement = statement;
+    if (self->statements_count == self->statements_size) {
+        uint32_t statements_size = self->statements_size == 0 ? 8 : self->statements_size * 2;
+        Parsed_Statement **statements = (Parsed_Statement **)Arena__allocate(parse_arena, statements_size * sizeof(Parsed_Statement *));
+        if (self->statements_count > 0) {
+            memcpy(statements, self->statements, self->statements_count * sizeof(Parsed_Statement *));
+        }
+        self->statements = statements;
+        self->statements_size = statements_size;
     }
-    self->last_statement = statement;
+    self->statements[self->statements_count] = statement;
+    self->statements_count = self->statements_count + 1;
 }
 
 Parsed_Source *Parsed_Source__create() {
-    Parsed_Source *parsed_source = (Parsed_Source *)malloc(sizeof(Parsed_Source));
+    Parsed_Source *parsed_source = (Parsed_Source *)Arena__allocate(parse_arena, sizeof(Parsed_Source));
     parsed_source->first_source = NULL;
     parsed_source->statements = Parsed_Statements__create(true);
     return parsed_source;
@@ -40,7 +40,7 @@ typedef enum Parsed_Expression_Kind {
 
 typedef struct Parsed_Expression {
     Parsed_Expression_Kind kind;
-    Source_Location *location;
+    Source_Location location;
 } Parsed_Expression;
 
 typedef enum Parsed_Type_Kind {
@@ -53,10 +53,10 @@ typedef enum Parsed_Type_Kind {
 
 typedef struct Parsed_Type {
     Parsed_Type_Kind kind;
-    Source_Location *location;
+    Source_Location location;
 } Parsed_Type;
 
-Parsed_Type *Parsed_Type__create_kind(Parsed_Type_Kind kind, size_t kind_size, Source_Location *location);
+Parsed_Type *Parsed_Type__create_kind(Parsed_Type_Kind kind, size_t kind_size, Source_Location location);
 
 typedef struct Parsed_Array_Type {
     Parsed_Type super;
@@ -65,7 +65,7 @@ typedef struct Parsed_Array_Type {
     Parsed_Expression *size_expression;
 } Parsed_Array_Type;
 
-Parsed_Array_Type *Parsed_Array_Type__create(Source_Location *location, Parsed_Type *item_type, bool is_checked, Parsed_Expression *size_expression);
+Parsed_Array_Type *Parsed_Array_Type__create(Source_Location location, Parsed_Type *item_type, bool is_checked, Parsed_Expression *size_expression);
 
 typedef struct Parsed_Function_Parameter {
     Token *label;
@@ -82,7 +82,7 @@ typedef struct Parsed_Function_Type {
     Parsed_Type *return_type;
 } Parsed_Function_Type;
 
-Parsed_Type *Parsed_Function_Type__create(Source_Location *location, Parsed_Function_Parameter *first_parameter, Parsed_Type *return_type);
+Parsed_Type *Parsed_Function_Type__create(Source_Location location, Parsed_Function_Parameter *first_parameter, Parsed_Type *return_type);
 
 typedef struct Parsed_Named_Type {
     Parsed_Type super;
@@ -102,9 +102,9 @@ typedef struct Parsed_Receiver_Type {
     Parsed_Type super;
 } Parsed_Receiver_Type;
 
-Parsed_Receiver_Type *Parsed_Receiver_Type__create(Source_Location *location);
+Parsed_Receiver_Type *Parsed_Receiver_Type__create(Source_Location location);
 
-Parsed_Expression *Parsed_Expression__create_kind(Parsed_Expression_Kind kind, size_t kind_size, Source_Location *location);
+Parsed_Expression *Parsed_Expression__create_kind(Parsed_Expression_Kind kind, size_t kind_size, Source_Location location);
 
 typedef struct Parsed_Binary_Expression {
     Parsed_Expression super;
@@ -119,7 +119,7 @@ typedef struct Parsed_Unary_Expression {
     Parsed_Expression *other_expression;
 } Parsed_Unary_Expression;
 
-Parsed_Unary_Expression *Parsed_Unary_Expression__create_kind(Parsed_Expression_Kind kind, size_t kind_size, Source_Location *location, Parsed_Expression *other_expression);
+Parsed_Unary_Expression *Parsed_Unary_Expression__create_kind(Parsed_Expression_Kind kind, size_t kind_size, Source_Location location, Parsed_Expression *other_expression);
 
 typedef struct Parsed_Literal_Expression {
     Parsed_Expression super;
@@ -138,7 +138,7 @@ typedef struct Parsed_Address_Of_Expression {
     Parsed_Unary_Expression super;
 } Parsed_Address_Of_Expression;
 
-Parsed_Address_Of_Expression *Parsed_Address_Of_Expression__create(Source_Location *location, Parsed_Expression *other_expression);
+Parsed_Address_Of_Expression *Parsed_Address_Of_Expression__create(Source_Location location, Parsed_Expression *other_expression);
 
 typedef struct Parsed_Array_Access_Expression {
     Parsed_Expression super;
@@ -156,13 +156,13 @@ typedef struct Parsed_Bool_Expression {
 Parsed_Bool_Expression *Parsed_Bool_Expression__create(Token *literal, bool value);
 
 typedef struct Parsed_Call_Argument {
-    Source_Location *location;
-    Identifier_Token *name;
+    Source_Location location;
+    Token *name;
     Parsed_Expression *expression;
     struct Parsed_Call_Argument *next_argument;
 } Parsed_Call_Argument;
 
-Parsed_Call_Argument *Parsed_Call_Argument__create(Source_Location *location, Identifier_Token *name, Parsed_Expression *expression);
+Parsed_Call_Argument *Parsed_Call_Argument__create(Source_Location location, Token *name, Parsed_Expression *expression);
 
 typedef struct Parsed_Call_Expression {
     Parsed_Expression super;
@@ -177,20 +177,20 @@ typedef struct Parsed_Cast_Expression {
     Parsed_Type *type;
 } Parsed_Cast_Expression;
 
-Parsed_Cast_Expression *Parsed_Cast_Expression__create(Source_Location *location, Parsed_Expression *other_expression, Parsed_Type *type);
+Parsed_Cast_Expression *Parsed_Cast_Expression__create(Source_Location location, Parsed_Expression *other_expression, Parsed_Type *type);
 
 typedef struct Parsed_Character_Expression {
     Parsed_Literal_Expression super;
     char value;
 } Parsed_Character_Expression;
 
-Parsed_Character_Expression *Parsed_Character_Expression__create(Character_Token *literal);
+Parsed_Character_Expression *Parsed_Character_Expression__create(Token *literal);
 
 typedef struct Parsed_Dereference_Expression {
     Parsed_Unary_Expression super;
 } Parsed_Dereference_Expression;
 
-Parsed_Dereference_Expression *Parsed_Dereference_Expression__create(Source_Location *location, Parsed_Expression *other_expression);
+Parsed_Dereference_Expression *Parsed_Dereference_Expression__create(Source_Location location, Parsed_Expression *other_expression);
 
 typedef struct Parsed_Divide_Expression {
     Parsed_Binary_Expression super;
@@ -221,7 +221,7 @@ typedef struct Parsed_Group_Expression {
     Parsed_Expression *other_expression;
 } Parsed_Group_Expression;
 
-Parsed_Group_Expression *Parsed_Group_Expression__create(Source_Location *location, Parsed_Expression *other_expression);
+Parsed_Group_Expression *Parsed_Group_Expression__create(Source_Location location, Parsed_Expression *other_expression);
 
 typedef struct Parsed_Integer_Expression {
     Parsed_Literal_Expression super;
@@ -229,7 +229,7 @@ typedef struct Parsed_Integer_Expression {
     Parsed_Named_Type *type;
 } Parsed_Integer_Expression;
 
-Parsed_Integer_Expression *Parsed_Integer_Expression__create(Integer_Token *literal, Parsed_Named_Type *type);
+Parsed_Integer_Expression *Parsed_Integer_Expression__create(Token *literal, Parsed_Named_Type *type);
 
 typedef struct Parsed_Less_Expression {
     Parsed_Binary_Expression super;
@@ -261,7 +261,7 @@ typedef struct Parsed_Make_Expression {
     Parsed_Call_Argument *first_argument;
 } Parsed_Make_Expression;
 
-Parsed_Make_Expression *Parsed_Make_Expression__create(Source_Location *location, Parsed_Type *type, Parsed_Call_Argument *first_argument);
+Parsed_Make_Expression *Parsed_Make_Expression__create(Source_Location location, Parsed_Type *type, Parsed_Call_Argument *first_argument);
 
 typedef struct Parsed_Member_Access_Expression {
     Parsed_Expression super;
@@ -275,7 +275,7 @@ typedef struct Parsed_Minus_Expression {
     Parsed_Unary_Expression super;
 } Parsed_Minus_Expression;
 
-Parsed_Minus_Expression *Parsed_Minus_Expression__create(Source_Location *location, Parsed_Expression *other_expression);
+Parsed_Minus_Expression *Parsed_Minus_Expression__create(Source_Location location, Parsed_Expression *other_expression);
 
 typedef struct Parsed_Modulo_Expression {
     Parsed_Binary_Expression super;
@@ -293,7 +293,7 @@ typedef struct Parsed_Not_Expression {
     Parsed_Unary_Expression super;
 } Parsed_Not_Expression;
 
-Parsed_Not_Expression *Parsed_Not_Expression__create(Source_Location *location, Parsed_Expression *other_expression);
+Parsed_Not_Expression *Parsed_Not_Expression__create(Source_Location location, Parsed_Expression *other_expression);
 
 typedef struct Parsed_Not_Equals_Expression {
     Parsed_Binary_Expression super;
@@ -312,14 +312,14 @@ typedef struct Parsed_Sizeof_Expression {
     Parsed_Type *type;
 } Parsed_Sizeof_Expression;
 
-Parsed_Sizeof_Expression *Parsed_Sizeof_Expression__create(Source_Location *location, Parsed_Type *type);
+Parsed_Sizeof_Expression *Parsed_Sizeof_Expression__create(Source_Location location, Parsed_Type *type);
 
 typedef struct Parsed_String_Expression {
     Parsed_Literal_Expression super;
     String *value;
 } Parsed_String_Expression;
 
-Parsed_String_Expression *Parsed_String_Expression__create(String_Token *literal);
+Parsed_String_Expression *Parsed_String_Expression__create(Token *literal);
 
 typedef struct Parsed_Substract_Expression {
     Parsed_Binary_Expression super;
@@ -352,15 +352,16 @@ typedef enum Parsed_Statement_Kind {
 
 typedef struct Parsed_Statement {
     Parsed_Statement_Kind kind;
-    Source_Location *location;
-    struct Parsed_Statement *next_statement;
+    Source_Location location;
 } Parsed_Statement;
 
-Parsed_Statement *Parsed_Statement__create_kind(Parsed_Statement_Kind kind, size_t kind_size, Source_Location *location);
+Parsed_Statement *Parsed_Statement__create_kind(Parsed_Statement_Kind kind, size_t kind_size, Source_Location location);
 
+/* The statements are stored contiguously, in order */
 typedef struct Parsed_Statements {
-    Parsed_Statement *first_statement;
-    Parsed_Statement *last_statement;
+    Parsed_Statement **statements;
+    uint32_t statements_count;
+    uint32_t statements_size;
     bool has_globals;
 } Parsed_Statements;
 
@@ -373,7 +374,7 @@ typedef struct Parsed_Named_Statement {
     Token *name;
 } Parsed_Named_Statement;
 
-Parsed_Named_Statement *Parsed_Named_Statement__create_kind(Parsed_Statement_Kind kind, size_t kind_size, Source_Location *location, Token *name);
+Parsed_Named_Statement *Parsed_Named_Statement__create_kind(Parsed_Statement_Kind kind, size_t kind_size, Source_Location location, Token *name);
 
 typedef struct Parsed_Assignment_Statement {
     Parsed_Statement super;
@@ -388,13 +389,13 @@ typedef struct Parsed_Block_Statement {
     struct Parsed_Statements *statements;
 } Parsed_Block_Statement;
 
-Parsed_Block_Statement *Parsed_Block_Statement__create(Source_Location *location, struct Parsed_Statements *statements);
+Parsed_Block_Statement *Parsed_Block_Statement__create(Source_Location location, struct Parsed_Statements *statements);
 
 typedef struct Parsed_Break_Statement {
     Parsed_Statement super;
 } Parsed_Break_Statement;
 
-Parsed_Statement *Parsed_Break_Statement__create(Source_Location *location);
+Parsed_Statement *Parsed_Break_Statement__create(Source_Location location);
 
 typedef struct Parsed_Expression_Statement {
     Parsed_Statement super;
@@ -407,7 +408,7 @@ typedef struct Parsed_External_Type_Statement {
     Parsed_Named_Statement super;
 } Parsed_External_Type_Statement;
 
-Parsed_External_Type_Statement *Parsed_External_Type_Statement__create(Source_Location *location, Token *name);
+Parsed_External_Type_Statement *Parsed_External_Type_Statement__create(Source_Location location, Token *name);
 
 typedef struct Parsed_Function_Statement {
     Parsed_Named_Statement super;
@@ -418,7 +419,7 @@ typedef struct Parsed_Function_Statement {
     bool is_external;
 } Parsed_Function_Statement;
 
-Parsed_Statement *Parsed_Function_Statement__create(Source_Location *location, Token *name, Parsed_Type *receiver_type, Parsed_Function_Parameter *first_parameter, Parsed_Type *resturn_type, struct Parsed_Statements *statements, bool is_external);
+Parsed_Statement *Parsed_Function_Statement__create(Source_Location location, Token *name, Parsed_Type *receiver_type, Parsed_Function_Parameter *first_parameter, Parsed_Type *resturn_type, struct Parsed_Statements *statements, bool is_external);
 
 typedef struct Parsed_If_Statement {
     Parsed_Statement super;
@@ -427,21 +428,21 @@ typedef struct Parsed_If_Statement {
     Parsed_Statement *false_statement;
 } Parsed_If_Statement;
 
-Parsed_Statement *Parsed_If_Statement__create(Source_Location *location, Parsed_Expression *condition_expression, Parsed_Statement *true_statement, Parsed_Statement *false_statement);
+Parsed_Statement *Parsed_If_Statement__create(Source_Location location, Parsed_Expression *condition_expression, Parsed_Statement *true_statement, Parsed_Statement *false_statement);
 
 typedef struct Parsed_Loop_Statement {
     Parsed_Statement super;
     Parsed_Statement *body_statement;
 } Parsed_Loop_Statement;
 
-Parsed_Statement *Parsed_Loop_Statement__create(Source_Location *location, Parsed_Statement *body_statement);
+Parsed_Statement *Parsed_Loop_Statement__create(Source_Location location, Parsed_Statement *body_statement);
 
 typedef struct Parsed_Return_Statement {
     Parsed_Statement super;
     Parsed_Expression *expression;
 } Parsed_Return_Statement;
 
-Parsed_Statement *Parsed_Return_Statement__create(Source_Location *location, Parsed_Expression *expression);
+Parsed_Statement *Parsed_Return_Statement__create(Source_Location location, Parsed_Expression *expression);
 
 typedef struct Parsed_Struct_Member {
     Token *name;
@@ -464,24 +465,24 @@ typedef struct Parsed_Struct_Statement {
     Parsed_Struct_Method *first_method;
 } Parsed_Struct_Statement;
 
-Parsed_Struct_Statement *Parsed_Struct_Statement__create(Source_Location *location, Token *name);
+Parsed_Struct_Statement *Parsed_Struct_Statement__create(Source_Location location, Token *name);
 
 typedef struct Parsed_Trait_Method {
-    Source_Location *location;
+    Source_Location location;
     Token *name;
     Parsed_Function_Parameter *first_parameter;
     Parsed_Type *return_type;
     struct Parsed_Trait_Method *next_method;
 } Parsed_Trait_Method;
 
-Parsed_Trait_Method *Parsed_Trait_Method__create(Source_Location *location, Token *name, Parsed_Function_Parameter *first_parameter, Parsed_Type *return_type);
+Parsed_Trait_Method *Parsed_Trait_Method__create(Source_Location location, Token *name, Parsed_Function_Parameter *first_parameter, Parsed_Type *return_type);
 
 typedef struct Parsed_Trait_Statement {
     Parsed_Named_Statement super;
     Parsed_Trait_Method *first_method;
 } Parsed_Trait_Statement;
 
-Parsed_Trait_Statement *Parsed_Trait_Statement__create(Source_Location *location, Token *name);
+Parsed_Trait_Statement *Parsed_Trait_Statement__create(Source_Location location, Token *name);
 
 typedef struct Parsed_Variable_Statement {
     Parsed_Named_Statement super;
@@ -490,7 +491,7 @@ typedef struct Parsed_Variable_Statement {
     bool is_external;
 } Parsed_Variable_Statement;
 
-Parsed_Variable_Statement *Parsed_Variable_Statement__create(Source_Location *location, Token *name, Parsed_Type *type, Parsed_Expression *expression, bool is_external);
+Parsed_Variable_Statement *Parsed_Variable_Statement__create(Source_Location location, Token *name, Parsed_Type *type, Parsed_Expression *expression, bool is_external);
 
 typedef struct Parsed_While_Statement {
     Parsed_Statement super;
@@ -498,7 +499,7 @@ typedef struct Parsed_While_Statement {
     Parsed_Statement *body_statement;
 } Parsed_While_Statement;
 
-Parsed_Statement *Parsed_While_Statement__create(Source_Location *location, Parsed_Expression *condition_expression, Parsed_Statement *body_statement);
+Parsed_Statement *Parsed_While_Statement__create(Source_Location location, Parsed_Expression *condition_expression, Parsed_Statement *body_statement);
 
 typedef struct Parsed_Source {
     Source *first_source;
@@ -1,80 +1,116 @@
 /* Copyright (C) 2024 Stefan Selariu */
 
 #include "Parser.h"
+#include "Char.h"
 #include "File.h"
+#include "Worker.h"
+
+/* Sources bigger than this are parsed in ranges of top level declarations, by all workers */
+#ifndef PARSER__CHUNK_SIZE
+#define PARSER__CHUNK_SIZE (64 * 1024)
+#endif
 
 typedef struct Parser {
     Scanner *scanner;
     Parsed_Source *parsed_source;
     uint16_t current_identation;
+    uint16_t expression_depth;
 } Parser;
 
 Token *Parser__peek_token(Parser *self, uint8_t offset) {
     return Scanner__peek_token(self->scanner, offset);
 }
 
-bool Parser__matches_three(Parser *self, bool (*first_is)(struct Token *token), bool first_required, bool (*second_is)(Token *token), bool second_required, bool (*third_is)(Token *token)) {
-    uint8_t peek_offset = 0;
-    if (first_is(Parser__peek_token(self, peek_offset))) {
-        peek_offset = peek_offset + 1;
-    } else if (first_required) {
-        return false;
-    }
-    if (second_is != NULL) {
-        if (second_is(Parser__peek_token(self, peek_offset))) {
-            peek_offset = peek_offset + 1;
-        } else if (second_required) {
-            return false;
-        }
-    }
-    if (third_is != NULL) {
-        return third_is(Parser__peek_token(self, peek_offset));
-    }
-    return true;
+/*
+ * The scanner attaches spaces and comments to the next token as trivia, and the parser
+ * consumes them explicitly. A token matches only after its trivia has been consumed.
+ */
+bool Parser__has_trivia(Token *token) {
+    return token->leading_spaces > 0 || token->comment_length > 0;
 }
 
-bool Parser__matches_two(Parser *self, bool (*first_is)(Token *token), bool first_required, bool (*second_is)(Token *token)) {
-    return Parser__matches_three(self, first_is, first_required, second_is, true, NULL);
+/* Returns the location of the first unconsumed trivia, or of the token itself */
+Source_Location Parser__current_location(Parser *self) {
+    Token *token = self->scanner->current_token;
+    if (!Parser__has_trivia(token)) {
+        return token->location;
+    }
+    return token->location - token->comment_length - token->leading_spaces;
 }
 
 bool Parser__matches_one(Parser *self, bool (*first_is)(Token *token)) {
-    return Parser__matches_two(self, first_is, true, NULL);
+    Token *token = Parser__peek_token(self, 0);
+    return !Parser__has_trivia(token) && first_is(token);
+}
+
+bool Parser__matches_one_after_space(Parser *self, bool (*first_is)(Token *token)) {
+    Token *token = Parser__peek_token(self, 0);
+    return token->comment_length == 0 && first_is(token);
+}
+
+/* The second token must follow the first one without spaces */
+bool Parser__matches_two_after_space(Parser *self, bool (*first_is)(Token *token), bool (*second_is)(Token *token)) {
+    return Parser__matches_one_after_space(self, first_is) && !Parser__has_trivia(Parser__peek_token(self, 1)) && second_is(Parser__peek_token(self, 1));
+}
+
+bool Parser__matches_comment(Parser *self) {
+    return Parser__peek_token(self, 0)->comment_length > 0;
 }
 
 bool Parser__matches_end_of_line(Parser *self) {
-    return Parser__matches_three(self, Token__is_space, false, Token__is_comment, false, Token__is_end_of_line);
+    return Token__is_end_of_line(Parser__peek_token(self, 0));
 }
 
 Token *Parser__consume_token(Parser *self, bool (*check)(Token *token)) {
     if (Parser__matches_one(self, check)) {
         Token *token = self->scanner->current_token;
+        switch (token->kind) {
+        case TOKEN_KIND__CHARACTER:
+        case TOKEN_KIND__IDENTIFIER:
+        case TOKEN_KIND__INTEGER:
+        case TOKEN_KIND__KEYWORD:
+        case TOKEN_KIND__STRING:
+            /* The scanner recycles its tokens, so the ones that might end up in the parsed source are copied */
+            token = Token__create_copy(token);
+            break;
+        default:
+            break;
+        }
         Scanner__next_token(self->scanner);
         return token;
     }
-    pWriter__begin_location_message(stderr_writer, self->scanner->current_token->location, WRITER_STYLE__ERROR);
+    pWriter__begin_location_message(stderr_writer, Parser__current_location(self), WRITER_STYLE__ERROR);
     pWriter__write__cstring(stderr_writer, "Unexpected token");
     pWriter__end_location_message(stderr_writer);
     panic();
 }
 
 void Parser__consume_comment(Parser *self) {
-    Parser__consume_token(self, Token__is_comment);
+    Token *token = self->scanner->current_token;
+    if (token->leading_spaces > 0 || token->comment_length == 0) {
+        pWriter__begin_location_message(stderr_writer, Parser__current_location(self), WRITER_STYLE__ERROR);
+        pWriter__write__cstring(stderr_writer, "Unexpected token");
+        pWriter__end_location_message(stderr_writer);
+        panic();
+    }
+    token->comment_length = 0;
 }
 
 void Parser__consume_space(Parser *self, uint16_t count) {
-    if (Parser__matches_one(self, Token__is_space)) {
-        Space_Token *token = (Space_Token *)Parser__consume_token(self, Token__is_space);
-        if (token->count != count) {
-            pWriter__begin_location_message(stderr_writer, token->super.location, WRITER_STYLE__WARNING);
+    Token *token = self->scanner->current_token;
+    if (token->leading_spaces > 0) {
+        if (token->leading_spaces != count) {
+            pWriter__begin_location_message(stderr_writer, Parser__current_location(self), WRITER_STYLE__WARNING);
             pWriter__write__cstring(stderr_writer, "Consumed: ");
-            pWriter__write__int64(stderr_writer, token->count);
+            pWriter__write__int64(stderr_writer, token->leading_spaces);
             pWriter__write__cstring(stderr_writer, " spaces where ");
             pWriter__write__int64(stderr_writer, count);
             pWriter__write__cstring(stderr_writer, " were expected");
             pWriter__end_location_message(stderr_writer);
         }
+        token->leading_spaces = 0;
     } else if (count > 0) {
-        pWriter__begin_location_message(stderr_writer, self->scanner->current_token->location, WRITER_STYLE__WARNING);
+        pWriter__begin_location_message(stderr_writer, Parser__current_location(self), WRITER_STYLE__WARNING);
         pWriter__write__cstring(stderr_writer, "Consumed 0 spaces where ");
         pWriter__write__int64(stderr_writer, count);
         pWriter__write__cstring(stderr_writer, " were expected");
@@ -83,7 +119,7 @@ void Parser__consume_space(Parser *self, uint16_t count) {
 }
 
 void Parser__consume_end_of_line(Parser *self) {
-    if (Parser__matches_two(self, Token__is_space, false, Token__is_comment)) {
+    if (Parser__matches_comment(self)) {
         Parser__consume_space(self, 1);
         Parser__consume_comment(self);
     } else {
@@ -101,8 +137,8 @@ bool Parser__consume_empty_line(Parser *self) {
     if (Parser__matches_one(self, Token__is_end_of_file)) {
         return false;
     }
-    if (Parser__matches_three(self, Token__is_space, false, Token__is_comment, false, Token__is_end_of_line)) {
-        if (Parser__matches_two(self, Token__is_space, false, Token__is_comment)) {
+    if (Parser__matches_end_of_line(self)) {
+        if (Parser__matches_comment(self)) {
             Parser__consume_space(self, self->current_identation * 4);
             Parser__consume_comment(self);
         } else {
@@ -131,7 +167,7 @@ primary_expression
 */
 Parsed_Expression *Parser__parse_primary_expression(Parser *self) {
     if (Parser__matches_one(self, Token__is_make)) {
-        Source_Location *location = Parser__consume_token(self, Token__is_make)->location;
+        Source_Location location = Parser__consume_token(self, Token__is_make)->location;
         Parser__consume_space(self, 1);
         Parsed_Type *type = Parser__parse_type(self);
         Parser__consume_space(self, 0);
@@ -153,10 +189,10 @@ Parsed_Expression *Parser__parse_primary_expression(Parser *self) {
         return (Parsed_Expression *)Parsed_Symbol_Expression__create(Parser__consume_token(self, Token__is_identifier));
     }
     if (Parser__matches_one(self, Token__is_integer)) {
-        Integer_Token *integer_token = (Integer_Token *)Parser__consume_token(self, Token__is_integer);
+        Token *integer_token = Parser__consume_token(self, Token__is_integer);
         Parsed_Named_Type *integer_type = NULL;
         Token *next_token = Parser__peek_token(self, 0);
-        if (Token__is_identifier(next_token)) {
+        if (!Parser__has_trivia(next_token) && Token__is_identifier(next_token)) {
             if (next_token->lexeme->data[0] == 'i' || next_token->lexeme->data[0] == 'u') {
                 if (next_token->lexeme->length == 2 && next_token->lexeme->data[1] == '8') {
                     integer_type = (Parsed_Named_Type *)Parsed_Named_Type__create(Parser__consume_token(self, Token__is_identifier));
@@ -178,20 +214,20 @@ Parsed_Expression *Parser__parse_primary_expression(Parser *self) {
         return (Parsed_Expression *)Parsed_Integer_Expression__create(integer_token, integer_type);
     }
     if (Parser__matches_one(self, Token__is_character)) {
-        return (Parsed_Expression *)Parsed_Character_Expression__create((Character_Token *)Parser__consume_token(self, Token__is_character));
+        return (Parsed_Expression *)Parsed_Character_Expression__create(Parser__consume_token(self, Token__is_character));
     }
     if (Parser__matches_one(self, Token__is_string)) {
-        return (Parsed_Expression *)Parsed_String_Expression__create((String_Token *)Parser__consume_token(self, Token__is_string));
+        return (Parsed_Expression *)Parsed_String_Expression__create(Parser__consume_token(self, Token__is_string));
     }
     if (Parser__matches_one(self, Token__is_opening_paren)) {
-        Source_Location *location = Parser__consume_token(self, Token__is_opening_paren)->location;
+        Source_Location location = Parser__consume_token(self, Token__is_opening_paren)->location;
         Parser__consume_space(self, 0);
         Parsed_Expression *expression = Parser__parse_expression(self);
         Parser__consume_space(self, 0);
         Parser__consume_token(self, Token__is_closing_paren);
         return (Parsed_Expression *)Parsed_Group_Expression__create(location, expression);
     }
-    pWriter__begin_location_message(stderr_writer, self->scanner->current_token->location, WRITER_STYLE__ERROR);
+    pWriter__begin_location_message(stderr_writer, Parser__current_location(self), WRITER_STYLE__ERROR);
     pWriter__write__cstring(stderr_writer, "Unsupported primary expression");
     pWriter__end_location_message(stderr_writer);
     panic();
@@ -202,10 +238,10 @@ call_argument
     | ( IDENTIFIER ":" )? expression
 */
 Parsed_Call_Argument *Parser__parse_call_argument(Parser *self) {
-    Source_Location *argument_location = self->scanner->current_token->location;
-    Identifier_Token *argument_name = NULL;
-    if (Parser__matches_three(self, Token__is_identifier, true, Token__is_space, false, Token__is_colon)) {
-        argument_name = (Identifier_Token *)Parser__consume_token(self, Token__is_identifier);
+    Source_Location argument_location = Parser__current_location(self);
+    Token *argument_name = NULL;
+    if (Parser__matches_one(self, Token__is_identifier) && Token__is_colon(Parser__peek_token(self, 1))) {
+        argument_name = Parser__consume_token(self, Token__is_identifier);
         Parser__consume_space(self, 0);
         Parser__consume_token(self, Token__is_colon);
         Parser__consume_space(self, 1);
@@ -227,7 +263,7 @@ Parsed_Call_Argument *Parser__parse_call_arguments(Parser *self) {
         while (Parser__consume_empty_line(self)) {
             /* ignored */
         }
-        while (!Parser__matches_two(self, Token__is_space, false, Token__is_closing_paren)) {
+        while (!Parser__matches_one_after_space(self, Token__is_closing_paren)) {
             Parser__consume_space(self, self->current_identation * 4);
             Parsed_Call_Argument *argument = Parser__parse_call_argument(self);
             Parser__consume_end_of_line(self);
@@ -244,7 +280,7 @@ Parsed_Call_Argument *Parser__parse_call_arguments(Parser *self) {
         }
         self->current_identation = self->current_identation - 1;
         Parser__consume_space(self, self->current_identation * 4);
-    } else if (!Parser__matches_two(self, Token__is_space, false, Token__is_closing_paren)) {
+    } else if (!Parser__matches_one_after_space(self, Token__is_closing_paren)) {
         first_argument = Parser__parse_call_argument(self);
         last_argument = first_argument;
         while (Parser__matches_one(self, Token__is_comma)) {
@@ -275,15 +311,15 @@ Parsed_Expression *Parser__parse_access_expression(Parser *self) {
     Parsed_Expression *expression = Parser__parse_primary_expression(self);
     while (true) {
         Parsed_Expression *old_expression = expression;
-        if (Parser__matches_two(self, Token__is_space, false, Token__is_dot)) {
+        if (Parser__matches_one_after_space(self, Token__is_dot)) {
             Parser__consume_space(self, 0);
             Parser__consume_token(self, Token__is_dot);
             Parser__consume_space(self, 0);
             if (Parser__matches_one(self, Token__is_at)) {
-                Source_Location *location = Parser__consume_token(self, Token__is_at)->location;
+                Source_Location location = Parser__consume_token(self, Token__is_at)->location;
                 expression = (Parsed_Expression *)Parsed_Dereference_Expression__create(location, expression);
             } else if (Parser__matches_one(self, Token__is_as)) {
-                Source_Location *location = Parser__consume_token(self, Token__is_as)->location;
+                Source_Location location = Parser__consume_token(self, Token__is_as)->location;
                 Parser__consume_space(self, 0);
                 Parser__consume_token(self, Token__is_opening_paren);
                 Parser__consume_space(self, 0);
@@ -296,7 +332,7 @@ Parsed_Expression *Parser__parse_access_expression(Parser *self) {
                 expression = (Parsed_Expression *)Parsed_Member_Access_Expression__create(expression, name);
             }
         }
-        if (Parser__matches_two(self, Token__is_space, false, Token__is_opening_paren)) {
+        if (Parser__matches_one_after_space(self, Token__is_opening_paren)) {
             Parser__consume_space(self, 0);
             Parser__consume_token(self, Token__is_opening_paren);
             Parser__consume_space(self, 0);
@@ -304,7 +340,7 @@ Parsed_Expression *Parser__parse_access_expression(Parser *self) {
             Parser__consume_token(self, Token__is_closing_paren);
             expression = (Parsed_Expression *)Parsed_Call_Expression__create(expression, call_arguments);
         }
-        if (Parser__matches_two(self, Token__is_space, false, Token__is_opening_bracket)) {
+        if (Parser__matches_one_after_space(self, Token__is_opening_bracket)) {
             Parser__consume_space(self, 0);
             Parser__consume_token(self, Token__is_opening_bracket);
             Parser__consume_space(self, 0);
@@ -320,6 +356,9 @@ Parsed_Expression *Parser__parse_access_expression(Parser *self) {
     return expression;
 }
 
+/* Nesting deeper than this is reported instead of exhausting the C stack */
+#define PARSER__MAX_EXPRESSION_DEPTH 4096
+
 /*
 unary_expression
     | "-" unary_expression
@@ -329,196 +368,164 @@ unary_expression
     | access_expression
 */
 Parsed_Expression *Parser__parse_unary_expression(Parser *self) {
+    if (self->expression_depth == PARSER__MAX_EXPRESSION_DEPTH) {
+        pWriter__begin_location_message(stderr_writer, Parser__current_location(self), WRITER_STYLE__ERROR);
+        pWriter__write__cstring(stderr_writer, "Expression nested too deep");
+        pWriter__end_location_message(stderr_writer);
+        panic();
+    }
+    self->expression_depth = self->expression_depth + 1;
+
+    Parsed_Expression *expression;
     if (Parser__matches_one(self, Token__is_minus)) {
-        Source_Location *location = Parser__consume_token(self, Token__is_minus)->location;
+        Source_Location location = Parser__consume_token(self, Token__is_minus)->location;
         Parser__consume_space(self, 0);
-        Parsed_Expression *expression = Parser__parse_unary_expression(self);
-        return (Parsed_Expression *)Parsed_Minus_Expression__create(location, expression);
-    }
-    if (Parser__matches_one(self, Token__is_not)) {
-        Source_Location *location = Parser__consume_token(self, Token__is_not)->location;
+        Parsed_Expression *other_expression = Parser__parse_unary_expression(self);
+        expression = (Parsed_Expression *)Parsed_Minus_Expression__create(location, other_expression);
+    } else if (Parser__matches_one(self, Token__is_not)) {
+        Source_Location location = Parser__consume_token(self, Token__is_not)->location;
         Parser__consume_space(self, 1);
-        Parsed_Expression *expression = Parser__parse_unary_expression(self);
-        return (Parsed_Expression *)Parsed_Not_Expression__create(location, expression);
-    }
-    if (Parser__matches_one(self, Token__is_at)) {
-        Source_Location *location = Parser__consume_token(self, Token__is_at)->location;
+        Parsed_Expression *other_expression = Parser__parse_unary_expression(self);
+        expression = (Parsed_Expression *)Parsed_Not_Expression__create(location, other_expression);
+    } else if (Parser__matches_one(self, Token__is_at)) {
+        Source_Location location = Parser__consume_token(self, Token__is_at)->location;
         Parser__consume_space(self, 0);
-        Parsed_Expression *expression = Parser__parse_unary_expression(self);
-        return (Parsed_Expression *)Parsed_Address_Of_Expression__create(location, expression);
-    }
-    if (Parser__matches_one(self, Token__is_sizeof)) {
-        Source_Location *location = Parser__consume_token(self, Token__is_sizeof)->location;
+        Parsed_Expression *other_expression = Parser__parse_unary_expression(self);
+        expression = (Parsed_Expression *)Parsed_Address_Of_Expression__create(location, other_expression);
+    } else if (Parser__matches_one(self, Token__is_sizeof)) {
+        Source_Location location = Parser__consume_token(self, Token__is_sizeof)->location;
         Parser__consume_space(self, 0);
         Parser__consume_token(self, Token__is_opening_paren);
         Parser__consume_space(self, 0);
         Parsed_Type *type = Parser__parse_type(self);
         Parser__consume_space(self, 0);
         Parser__consume_token(self, Token__is_closing_paren);
-        return (Parsed_Expression *)Parsed_Sizeof_Expression__create(location, type);
+        expression = (Parsed_Expression *)Parsed_Sizeof_Expression__create(location, type);
+    } else {
+        expression = Parser__parse_access_expression(self);
     }
-    return Parser__parse_access_expression(self);
-}
 
-bool Token__is_mutliplication(Token *self) {
-    return Token__is_asterisk(self) || Token__is_slash(self);
-}
-
-/*
-multiplication
-    | unary_expression ( ( "*" | "/" | "//" ) unary_expression )*
-*/
-Parsed_Expression *Parser__parse_multiplication_expression(Parser *self) {
-    Parsed_Expression *expression = Parser__parse_unary_expression(self);
-    while (Parser__matches_two(self, Token__is_space, false, Token__is_mutliplication)) {
-        Parser__consume_space(self, 1);
-        if (Parser__matches_one(self, Token__is_asterisk)) {
-            Parser__consume_token(self, Token__is_asterisk);
-            Parser__consume_space(self, 1);
-            Parsed_Expression *right_expression = Parser__parse_unary_expression(self);
-            expression = (Parsed_Expression *)Parsed_Multiply_Expression__create(expression, right_expression);
-        } else {
-            Parser__consume_token(self, Token__is_slash);
-            if (Parser__matches_one(self, Token__is_slash)) {
-                Parser__consume_token(self, Token__is_slash);
-                Parser__consume_space(self, 1);
-                Parsed_Expression *right_expression = Parser__parse_unary_expression(self);
-                expression = (Parsed_Expression *)Parsed_Modulo_Expression__create(expression, right_expression);
-            } else {
-                Parser__consume_space(self, 1);
-                Parsed_Expression *right_expression = Parser__parse_unary_expression(self);
-                expression = (Parsed_Expression *)Parsed_Divide_Expression__create(expression, right_expression);
-            }
-        }
-    }
+    self->expression_depth = self->expression_depth - 1;
     return expression;
 }
 
-bool Token__is_addition(Token *self) {
-    return Token__is_plus(self) || Token__is_minus(self);
-}
-
-/*
-addition
-    | multiplication ( ( "+" | "-" ) multiplication )*
-*/
-Parsed_Expression *Parser__parse_addition_expression(Parser *self) {
-    Parsed_Expression *expression = Parser__parse_multiplication_expression(self);
-    while (Parser__matches_two(self, Token__is_space, false, Token__is_addition)) {
-        Parser__consume_space(self, 1);
-        if (Parser__matches_one(self, Token__is_plus)) {
-            Parser__consume_token(self, Token__is_plus);
-            Parser__consume_space(self, 1);
-            Parsed_Expression *right_expression = Parser__parse_multiplication_expression(self);
-            expression = (Parsed_Expression *)Parsed_Add_Expression__create(expression, right_expression);
-        } else {
-            Parser__consume_token(self, Token__is_minus);
-            Parser__consume_space(self, 1);
-            Parsed_Expression *right_expression = Parser__parse_multiplication_expression(self);
-            expression = (Parsed_Expression *)Parsed_Substract_Expression__create(expression, right_expression);
-        }
+typedef enum Parser_Precedence {
+    PARSER_PRECEDENCE__NONE,
+    PARSER_PRECEDENCE__LOGIC_OR,
+    PARSER_PRECEDENCE__LOGIC_AND,
+    PARSER_PRECEDENCE__EQUALITY,
+    PARSER_PRECEDENCE__COMPARISON,
+    PARSER_PRECEDENCE__ADDITION,
+    PARSER_PRECEDENCE__MULTIPLICATION
+} Parser_Precedence;
+
+typedef struct Parser_Binary_Operator {
+    Parsed_Expression_Kind kind;
+    Parser_Precedence precedence;
+    /* Operators like "//" and "==" are made of two tokens */
+    uint8_t tokens_count;
+    /* Equality and comparison operators cannot be chained */
+    bool is_chainable;
+} Parser_Binary_Operator;
+
+static const Parser_Binary_Operator parser_binary_operators[] = {
+    [PARSED_EXPRESSION_KIND__ADD] = {PARSED_EXPRESSION_KIND__ADD, PARSER_PRECEDENCE__ADDITION, 1, true},
+    [PARSED_EXPRESSION_KIND__DIVIDE] = {PARSED_EXPRESSION_KIND__DIVIDE, PARSER_PRECEDENCE__MULTIPLICATION, 1, true},
+    [PARSED_EXPRESSION_KIND__EQUALS] = {PARSED_EXPRESSION_KIND__EQUALS, PARSER_PRECEDENCE__EQUALITY, 2, false},
+    [PARSED_EXPRESSION_KIND__GREATER] = {PARSED_EXPRESSION_KIND__GREATER, PARSER_PRECEDENCE__COMPARISON, 1, false},
+    [PARSED_EXPRESSION_KIND__GREATER_OR_EQUALS] = {PARSED_EXPRESSION_KIND__GREATER_OR_EQUALS, PARSER_PRECEDENCE__COMPARISON, 2, false},
+    [PARSED_EXPRESSION_KIND__LESS] = {PARSED_EXPRESSION_KIND__LESS, PARSER_PRECEDENCE__COMPARISON, 1, false},
+    [PARSED_EXPRESSION_KIND__LESS_OR_EQUALS] = {PARSED_EXPRESSION_KIND__LESS_OR_EQUALS, PARSER_PRECEDENCE__COMPARISON, 2, false},
+    [PARSED_EXPRESSION_KIND__LOGIC_AND] = {PARSED_EXPRESSION_KIND__LOGIC_AND, PARSER_PRECEDENCE__LOGIC_AND, 1, true},
+    [PARSED_EXPRESSION_KIND__LOGIC_OR] = {PARSED_EXPRESSION_KIND__LOGIC_OR, PARSER_PRECEDENCE__LOGIC_OR, 1, true},
+    [PARSED_EXPRESSION_KIND__MODULO] = {PARSED_EXPRESSION_KIND__MODULO, PARSER_PRECEDENCE__MULTIPLICATION, 2, true},
+    [PARSED_EXPRESSION_KIND__MULTIPLY] = {PARSED_EXPRESSION_KIND__MULTIPLY, PARSER_PRECEDENCE__MULTIPLICATION, 1, true},
+    [PARSED_EXPRESSION_KIND__NOT_EQUALS] = {PARSED_EXPRESSION_KIND__NOT_EQUALS, PARSER_PRECEDENCE__EQUALITY, 2, false},
+    [PARSED_EXPRESSION_KIND__SUBSTRACT] = {PARSED_EXPRESSION_KIND__SUBSTRACT, PARSER_PRECEDENCE__ADDITION, 1, true},
+};
+
+/* Returns the binary operator that follows, or NULL */
+const Parser_Binary_Operator *Parser__peek_binary_operator(Parser *self) {
+    Token *token = Parser__peek_token(self, 0);
+    if (token->comment_length > 0) {
+        return NULL;
     }
-    return expression;
-}
-
-/*
-comparison
-    | addition ( ( "<=" | "<" | ">" | ">=") addition )*
-*/
-Parsed_Expression *Parser__parse_comparison_expression(Parser *self) {
-    Parsed_Expression *expression = Parser__parse_addition_expression(self);
-    if (Parser__matches_two(self, Token__is_space, false, Token__is_less_than)) {
-        Parser__consume_space(self, 1);
-        Parser__consume_token(self, Token__is_less_than);
-        if (Parser__matches_one(self, Token__is_equals)) {
-            Parser__consume_token(self, Token__is_equals);
-            Parser__consume_space(self, 1);
-            Parsed_Expression *right_expression = Parser__parse_addition_expression(self);
-            expression = (Parsed_Expression *)Parsed_Less_Or_Equals_Expression__create(expression, right_expression);
-        } else {
-            Parser__consume_space(self, 1);
-            Parsed_Expression *right_expression = Parser__parse_addition_expression(self);
-            expression = (Parsed_Expression *)Parsed_Less_Expression__create(expression, right_expression);
+    Token *next_token = Parser__peek_token(self, 1);
+    bool is_followed_by_equals = !Parser__has_trivia(next_token) && Token__is_equals(next_token);
+    switch (token->kind) {
+    case TOKEN_KIND__KEYWORD:
+        switch (token->keyword) {
+        case TOKEN_KEYWORD__AND:
+            return &parser_binary_operators[PARSED_EXPRESSION_KIND__LOGIC_AND];
+        case TOKEN_KEYWORD__OR:
+            return &parser_binary_operators[PARSED_EXPRESSION_KIND__LOGIC_OR];
+        default:
+            return NULL;
         }
-    } else if (Parser__matches_two(self, Token__is_space, false, Token__is_greater_than)) {
-        Parser__consume_space(self, 1);
-        Parser__consume_token(self, Token__is_greater_than);
-        if (Parser__matches_one(self, Token__is_equals)) {
-            Parser__consume_token(self, Token__is_equals);
-            Parser__consume_space(self, 1);
-            Parsed_Expression *right_expression = Parser__parse_addition_expression(self);
-            expression = (Parsed_Expression *)Parsed_Greater_Or_Equals_Expression__create(expression, right_expression);
-        } else {
-            Parser__consume_space(self, 1);
-            Parsed_Expression *right_expression = Parser__parse_addition_expression(self);
-            expression = (Parsed_Expression *)Parsed_Greater_Expression__create(expression, right_expression);
+    case TOKEN_KIND__OTHER:
+        switch (token->character_value) {
+        case '!':
+            return is_followed_by_equals ? &parser_binary_operators[PARSED_EXPRESSION_KIND__NOT_EQUALS] : NULL;
+        case '*':
+            return &parser_binary_operators[PARSED_EXPRESSION_KIND__MULTIPLY];
+        case '+':
+            return &parser_binary_operators[PARSED_EXPRESSION_KIND__ADD];
+        case '-':
+            return &parser_binary_operators[PARSED_EXPRESSION_KIND__SUBSTRACT];
+        case '/':
+            if (!Parser__has_trivia(next_token) && Token__is_slash(next_token)) {
+                return &parser_binary_operators[PARSED_EXPRESSION_KIND__MODULO];
+            }
+            return &parser_binary_operators[PARSED_EXPRESSION_KIND__DIVIDE];
+        case '<':
+            return &parser_binary_operators[is_followed_by_equals ? PARSED_EXPRESSION_KIND__LESS_OR_EQUALS : PARSED_EXPRESSION_KIND__LESS];
+        case '=':
+            return is_followed_by_equals ? &parser_binary_operators[PARSED_EXPRESSION_KIND__EQUALS] : NULL;
+        case '>':
+            return &parser_binary_operators[is_followed_by_equals ? PARSED_EXPRESSION_KIND__GREATER_OR_EQUALS : PARSED_EXPRESSION_KIND__GREATER];
+        default:
+            return NULL;
         }
+    default:
+        return NULL;
     }
-    return expression;
-}
-
-/*
-equality
-    | comparison ( ( "==" | "!=" ) comparison )*
-*/
-Parsed_Expression *Parser__parse_equality_expression(Parser *self) {
-    Parsed_Expression *expression = Parser__parse_comparison_expression(self);
-    if (Parser__matches_three(self, Token__is_space, false, Token__is_equals, true, Token__is_equals)) {
-        Parser__consume_space(self, 1);
-        Parser__consume_token(self, Token__is_equals);
-        Parser__consume_token(self, Token__is_equals);
-        Parser__consume_space(self, 1);
-        Parsed_Expression *right_expression = Parser__parse_comparison_expression(self);
-        expression = (Parsed_Expression *)Parsed_Equals_Expression__create(expression, right_expression);
-    } else if (Parser__matches_three(self, Token__is_space, false, Token__is_exclamation_mark, true, Token__is_equals)) {
-        Parser__consume_space(self, 1);
-        Parser__consume_token(self, Token__is_exclamation_mark);
-        Parser__consume_token(self, Token__is_equals);
-        Parser__consume_space(self, 1);
-        Parsed_Expression *right_expression = Parser__parse_comparison_expression(self);
-        expression = (Parsed_Expression *)Parsed_Not_Equals_Expression__create(expression, right_expression);
-    }
-    return expression;
 }
 
 /*
-logic_and
-    | equality ( "and" equality )*
-*/
-Parsed_Expression *Parser__parse_logic_and_expression(Parser *self) {
-    Parsed_Expression *expression = Parser__parse_equality_expression(self);
-    while (Parser__matches_two(self, Token__is_space, false, Token__is_and)) {
-        Parser__consume_space(self, 1);
-        Parser__consume_token(self, Token__is_and);
-        Parser__consume_space(self, 1);
-        Parsed_Expression *right_expression = Parser__parse_equality_expression(self);
-        expression = (Parsed_Expression *)Parsed_Logic_And_Expression__create(expression, right_expression);
-    }
-    return expression;
-}
+binary_expression
+    | unary_expression ( OPERATOR unary_expression )*
 
-/*
-logic_or
-    | logic_and ( "or" logic_and )*
+Operators from the lowest to the highest precedence: "or", "and", ( "==" | "!=" ),
+( "<" | "<=" | ">" | ">=" ), ( "+" | "-" ), ( "*" | "/" | "//" ).
 */
-Parsed_Expression *Parser__parse_logic_or_expression(Parser *self) {
-    Parsed_Expression *expression = Parser__parse_logic_and_expression(self);
-    while (Parser__matches_two(self, Token__is_space, false, Token__is_or)) {
+Parsed_Expression *Parser__parse_binary_expression(Parser *self, Parser_Precedence min_precedence) {
+    Parsed_Expression *expression = Parser__parse_unary_expression(self);
+    Parser_Precedence max_precedence = PARSER_PRECEDENCE__MULTIPLICATION;
+    while (true) {
+        const Parser_Binary_Operator *operator = Parser__peek_binary_operator(self);
+        if (operator == NULL || operator->precedence < min_precedence || operator->precedence > max_precedence) {
+            break;
+        }
         Parser__consume_space(self, 1);
-        Parser__consume_token(self, Token__is_or);
+        for (uint8_t index = 0; index < operator->tokens_count; index++) {
+            Parser__consume_token(self, Token__is_anything);
+        }
         Parser__consume_space(self, 1);
-        Parsed_Expression *right_expression = Parser__parse_logic_and_expression(self);
-        expression = (Parsed_Expression *)Parsed_Logic_Or_Expression__create(expression, right_expression);
+        Parsed_Expression *right_expression = Parser__parse_binary_expression(self, operator->precedence + 1);
+        expression = (Parsed_Expression *)Parsed_Binary_Expression__create_kind(operator->kind, expression, right_expression);
+        if (!operator->is_chainable) {
+            max_precedence = operator->precedence - 1;
+        }
     }
     return expression;
 }
 
 /*
 expression
-    | logic_or
+    | binary_expression
 */
 Parsed_Expression *Parser__parse_expression(Parser *self) {
-    return Parser__parse_logic_or_expression(self);
+    return Parser__parse_binary_expression(self, PARSER_PRECEDENCE__LOGIC_OR);
 }
 
 Parsed_Statement *Parser__parse_function(Parser *self, Parsed_Type *receiver_type);
@@ -528,7 +535,7 @@ struct
     | "struct" IDENTIFIER "{" ( IDENTIFIER ":" type | function )* "}"
 */
 Parsed_Statement *Parser__parse_struct(Parser *self) {
-    Source_Location *struct_location = Parser__consume_token(self, Token__is_struct)->location;
+    Source_Location struct_location = Parser__consume_token(self, Token__is_struct)->location;
     Parser__consume_space(self, 1);
     Token *struct_name = Parser__consume_token(self, Token__is_identifier);
     Parsed_Struct_Statement *struct_statement = Parsed_Struct_Statement__create(struct_location, struct_name);
@@ -538,7 +545,7 @@ Parsed_Statement *Parser__parse_struct(Parser *self) {
     self->current_identation = self->current_identation + 1;
     Parsed_Struct_Member *last_struct_member = NULL;
     Parsed_Struct_Method *last_struct_method = NULL;
-    while (!Parser__matches_two(self, Token__is_space, false, Token__is_closing_brace)) {
+    while (!Parser__matches_one_after_space(self, Token__is_closing_brace)) {
         if (!Parser__consume_empty_line(self)) {
             Parser__consume_space(self, self->current_identation * 4);
             if (Parser__matches_one(self, Token__is_func)) {
@@ -582,7 +589,7 @@ trait
     | "trait" IDENTIFIER "{" trait_method* "}"
 */
 Parsed_Statement *Parser__parse_trait(Parser *self) {
-    Source_Location *trait_location = Parser__consume_token(self, Token__is_trait)->location;
+    Source_Location trait_location = Parser__consume_token(self, Token__is_trait)->location;
     Parser__consume_space(self, 1);
     Token *trait_name = Parser__consume_token(self, Token__is_identifier);
     Parsed_Trait_Statement *trait_statement = Parsed_Trait_Statement__create(trait_location, trait_name);
@@ -591,10 +598,10 @@ Parsed_Statement *Parser__parse_trait(Parser *self) {
     Parser__consume_end_of_line(self);
     self->current_identation = self->current_identation + 1;
     Parsed_Trait_Method *last_trait_method = NULL;
-    while (!Parser__matches_two(self, Token__is_space, false, Token__is_closing_brace)) {
+    while (!Parser__matches_one_after_space(self, Token__is_closing_brace)) {
         if (!Parser__consume_empty_line(self)) {
             Parser__consume_space(self, self->current_identation * 4);
-            Source_Location *method_location = Parser__consume_token(self, Token__is_func)->location;
+            Source_Location method_location = Parser__consume_token(self, Token__is_func)->location;
             Parser__consume_space(self, 1);
             Token *method_name = Parser__consume_token(self, Token__is_identifier);
             Parser__consume_space(self, 0);
@@ -603,7 +610,7 @@ Parsed_Statement *Parser__parse_trait(Parser *self) {
             Parser__consume_space(self, 0);
             Parser__consume_token(self, Token__is_closing_paren);
             Parsed_Type *return_type = NULL;
-            if (Parser__matches_two(self, Token__is_space, false, Token__is_minus)) {
+            if (Parser__matches_one_after_space(self, Token__is_minus)) {
                 Parser__consume_space(self, 1);
                 Parser__consume_token(self, Token__is_minus);
                 Parser__consume_token(self, Token__is_greater_than);
@@ -631,7 +638,7 @@ external_type
     | "external" "type" IDENTIFIER
 */
 Parsed_Statement *Parser__parse_external_type(Parser *self) {
-    Source_Location *location = Parser__consume_token(self, Token__is_external)->location;
+    Source_Location location = Parser__consume_token(self, Token__is_external)->location;
     Parser__consume_space(self, 1);
     Parser__consume_token(self, Token__is_type);
     Parser__consume_space(self, 1);
@@ -647,7 +654,7 @@ Parsed_Function_Parameter *Parser__parse_function_parameter(Parser *self) {
     bool anonymous = false;
     Token *label = NULL;
     Token *name = NULL;
-    if (Parser__matches_three(self, Token__is_identifier, true, Token__is_space, true, Token__is_identifier)) {
+    if (Parser__matches_one(self, Token__is_identifier) && Parser__peek_token(self, 1)->leading_spaces > 0 && Token__is_identifier(Parser__peek_token(self, 1))) {
         label = Parser__consume_token(self, Token__is_identifier);
         Parser__consume_space(self, 1);
         name = Parser__consume_token(self, Token__is_identifier);
@@ -671,7 +678,7 @@ function_parameters
 */
 Parsed_Function_Parameter *Parser__parse_function_parameters(Parser *self, Parsed_Type *receiver_type) {
     Parsed_Function_Parameter *first_parameter = NULL;
-    if (!Parser__matches_two(self, Token__is_space, false, Token__is_closing_paren)) {
+    if (!Parser__matches_one_after_space(self, Token__is_closing_paren)) {
         Parser__consume_space(self, 0);
         if (receiver_type != NULL) {
             Token *parameter_name = Parser__consume_token(self, Token__is_identifier);
@@ -680,7 +687,7 @@ Parsed_Function_Parameter *Parser__parse_function_parameters(Parser *self, Parse
             first_parameter = Parser__parse_function_parameter(self);
         }
         Parsed_Function_Parameter *last_parameter = first_parameter;
-        while (Parser__matches_two(self, Token__is_space, false, Token__is_comma)) {
+        while (Parser__matches_one_after_space(self, Token__is_comma)) {
             Parser__consume_space(self, 0);
             Parser__consume_token(self, Token__is_comma);
             Parser__consume_space(self, 1);
@@ -700,13 +707,13 @@ type
 */
 Parsed_Type *Parser__parse_type(Parser *self) {
     if (Parser__matches_one(self, Token__is_at)) {
-        Source_Location *location = Parser__consume_token(self, Token__is_at)->location;
+        Source_Location location = Parser__consume_token(self, Token__is_at)->location;
         Parser__consume_space(self, 0);
         Parsed_Type *type = Parser__parse_type(self);
         return Parsed_Pointer_Type__create(type);
     }
     if (Parser__matches_one(self, Token__is_opening_bracket)) {
-        Source_Location *location = Parser__consume_token(self, Token__is_opening_bracket)->location;
+        Source_Location location = Parser__consume_token(self, Token__is_opening_bracket)->location;
         Parser__consume_space(self, 0);
         Parsed_Type *item_type = Parser__parse_type(self);
         Parser__consume_space(self, 0);
@@ -730,14 +737,14 @@ Parsed_Type *Parser__parse_type(Parser *self) {
         return (Parsed_Type *)Parsed_Array_Type__create(location, item_type, true, NULL);
     }
     if (Parser__matches_one(self, Token__is_func)) {
-        Source_Location *location = Parser__consume_token(self, Token__is_func)->location;
+        Source_Location location = Parser__consume_token(self, Token__is_func)->location;
         Parser__consume_space(self, 1);
         Parser__consume_token(self, Token__is_opening_paren);
         Parsed_Function_Parameter *first_parameter = Parser__parse_function_parameters(self, NULL);
         Parser__consume_space(self, 0);
         Parser__consume_token(self, Token__is_closing_paren);
         Parsed_Type *return_type = NULL;
-        if (Parser__matches_two(self, Token__is_space, false, Token__is_minus)) {
+        if (Parser__matches_one_after_space(self, Token__is_minus)) {
             Parser__consume_space(self, 1);
             Parser__consume_token(self, Token__is_minus);
             Parser__consume_token(self, Token__is_greater_than);
@@ -756,7 +763,7 @@ variable
 */
 Parsed_Statement *Parser__parse_variable(Parser *self) {
     bool is_external;
-    Source_Location *location;
+    Source_Location location;
     if (Parser__matches_one(self, Token__is_external)) {
         is_external = true;
         location = Parser__consume_token(self, Token__is_external)->location;
@@ -767,14 +774,14 @@ Parsed_Statement *Parser__parse_variable(Parser *self) {
     Parser__consume_space(self, 1);
     Token *name = Parser__consume_token(self, Token__is_identifier);
     Parsed_Type *type = NULL;
-    if (Parser__matches_two(self, Token__is_space, false, Token__is_colon)) {
+    if (Parser__matches_one_after_space(self, Token__is_colon)) {
         Parser__consume_space(self, 0);
         Parser__consume_token(self, Token__is_colon);
         Parser__consume_space(self, 1);
         type = Parser__parse_type(self);
     }
     Parsed_Expression *expression = NULL;
-    if (Parser__matches_two(self, Token__is_space, false, Token__is_equals)) {
+    if (Parser__matches_one_after_space(self, Token__is_equals)) {
         Parser__consume_space(self, 1);
         Parser__consume_token(self, Token__is_equals);
         Parser__consume_space(self, 1);
@@ -790,7 +797,7 @@ block
     | "{" statements "}"
 */
 Parsed_Block_Statement *Parser__parse_block_statement(Parser *self) {
-    Source_Location *location = Parser__consume_token(self, Token__is_opening_brace)->location;
+    Source_Location location = Parser__consume_token(self, Token__is_opening_brace)->location;
     Parser__consume_end_of_line(self);
     Parsed_Statements *statements = Parsed_Statements__create(false);
     self->current_identation = self->current_identation + 1;
@@ -812,10 +819,10 @@ Parsed_Statement *Parser__parse_function(Parser *self, Parsed_Type *receiver_typ
         Parser__consume_token(self, Token__is_external);
         Parser__consume_space(self, 1);
     }
-    Source_Location *location = Parser__consume_token(self, Token__is_func)->location;
+    Source_Location location = Parser__consume_token(self, Token__is_func)->location;
     Parser__consume_space(self, 1);
     Token *name = NULL;
-    if (Parser__matches_three(self, Token__is_identifier, true, Token__is_space, false, Token__is_opening_paren)) {
+    if (Parser__matches_one(self, Token__is_identifier) && Token__is_opening_paren(Parser__peek_token(self, 1))) {
         name = Parser__consume_token(self, Token__is_identifier);
     } else {
         Parsed_Type *type = Parser__parse_type(self);
@@ -837,7 +844,7 @@ Parsed_Statement *Parser__parse_function(Parser *self, Parsed_Type *receiver_typ
     Parser__consume_space(self, 0);
     Parser__consume_token(self, Token__is_closing_paren);
     Parsed_Type *return_type = NULL;
-    if (Parser__matches_two(self, Token__is_space, false, Token__is_minus)) {
+    if (Parser__matches_one_after_space(self, Token__is_minus)) {
         Parser__consume_space(self, 1);
         Parser__consume_token(self, Token__is_minus);
         Parser__consume_token(self, Token__is_greater_than);
@@ -845,7 +852,7 @@ Parsed_Statement *Parser__parse_function(Parser *self, Parsed_Type *receiver_typ
         return_type = Parser__parse_type(self);
     }
     Parsed_Statements *statements = NULL;
-    if (Parser__matches_two(self, Token__is_space, false, Token__is_opening_brace)) {
+    if (Parser__matches_one_after_space(self, Token__is_opening_brace)) {
         Parser__consume_space(self, 1);
         Parser__consume_token(self, Token__is_opening_brace);
         Parser__consume_end_of_line(self);
@@ -864,7 +871,7 @@ return
     | "return" expression?
 */
 Parsed_Statement *Parser__parse_return_statement(Parser *self) {
-    Source_Location *location = Parser__consume_token(self, Token__is_return)->location;
+    Source_Location location = Parser__consume_token(self, Token__is_return)->location;
     Parsed_Expression *expression = NULL;
     if (!Parser__matches_end_of_line(self)) {
         Parser__consume_space(self, 1);
@@ -878,7 +885,7 @@ break
     | "break" ";"
 */
 Parsed_Statement *Parser__parse_break_statement(Parser *self) {
-    Source_Location *location = Parser__consume_token(self, Token__is_break)->location;
+    Source_Location location = Parser__consume_token(self, Token__is_break)->location;
     return Parsed_Break_Statement__create(location);
 }
 
@@ -887,13 +894,13 @@ if
     | "if" expression block ( "else" ( if |  block ) )?
 */
 Parsed_Statement *Parser__parse_if_statement(Parser *self) {
-    Source_Location *location = Parser__consume_token(self, Token__is_if)->location;
+    Source_Location location = Parser__consume_token(self, Token__is_if)->location;
     Parser__consume_space(self, 1);
     Parsed_Expression *condition_expression = Parser__parse_expression(self);
     Parser__consume_space(self, 1);
     Parsed_Statement *true_statement = (Parsed_Statement *)Parser__parse_block_statement(self);
     Parsed_Statement *false_statement = NULL;
-    if (Parser__matches_two(self, Token__is_space, false, Token__is_else)) {
+    if (Parser__matches_one_after_space(self, Token__is_else)) {
         Parser__consume_space(self, 1);
         Parser__consume_token(self, Token__is_else);
         Parser__consume_space(self, 1);
@@ -911,7 +918,7 @@ loop
     | "loop" block
 */
 Parsed_Statement *Parser__parse_loop_statement(Parser *self) {
-    Source_Location *location = Parser__consume_token(self, Token__is_loop)->location;
+    Source_Location location = Parser__consume_token(self, Token__is_loop)->location;
     Parser__consume_space(self, 1);
     Parsed_Statement *body_statement = (Parsed_Statement *)Parser__parse_block_statement(self);
     return Parsed_Loop_Statement__create(location, body_statement);
@@ -922,7 +929,7 @@ while
     | "while" expression block
 */
 Parsed_Statement *Parser__parse_while_statement(Parser *self) {
-    Source_Location *location = Parser__consume_token(self, Token__is_while)->location;
+    Source_Location location = Parser__consume_token(self, Token__is_while)->location;
     Parser__consume_space(self, 1);
     Parsed_Expression *condition_expression = Parser__parse_expression(self);
     Parser__consume_space(self, 1);
@@ -947,12 +954,13 @@ statement
 Parsed_Statement *Parser__parse_statement(Parser *self) {
     Parser__consume_space(self, self->current_identation * 4);
 
-    if (Parser__matches_two(self, Token__is_external, true, Token__is_space)) {
-        if (Token__is_func(Parser__peek_token(self, 2))) {
+    if (Parser__matches_one(self, Token__is_external) && Parser__peek_token(self, 1)->leading_spaces > 0) {
+        Token *next_token = Parser__peek_token(self, 1);
+        if (next_token->comment_length == 0 && Token__is_func(next_token)) {
             return Parser__parse_function(self, NULL);
         }
 
-        if (Token__is_type(Parser__peek_token(self, 2))) {
+        if (next_token->comment_length == 0 && Token__is_type(next_token)) {
             return Parser__parse_external_type(self);
         }
 
@@ -997,7 +1005,7 @@ Parsed_Statement *Parser__parse_statement(Parser *self) {
 
     Parsed_Expression *expresion = Parser__parse_access_expression(self);
 
-    if (Parser__matches_two(self, Token__is_space, false, Token__is_equals)) {
+    if (Parser__matches_one_after_space(self, Token__is_equals)) {
         Parser__consume_space(self, 1);
         Parser__consume_token(self, Token__is_equals);
         Parser__consume_space(self, 1);
@@ -1019,11 +1027,11 @@ void Parser__parse_statements(Parser *self, Parsed_Statements *statements) {
         }
 
         if (statements->has_globals) {
-            if (Parser__matches_three(self, Token__is_space, false, Token__is_comment, false, Token__is_end_of_line)) {
+            if (Parser__matches_end_of_line(self)) {
                 return;
             }
         } else {
-            if (Parser__matches_two(self, Token__is_space, false, Token__is_closing_brace)) {
+            if (Parser__matches_one_after_space(self, Token__is_closing_brace)) {
                 return;
             }
         }
@@ -1036,24 +1044,122 @@ void Parser__parse_statements(Parser *self, Parsed_Statements *statements) {
     }
 }
 
-void Parser__parse_source(Parser *self, Source *source) {
-    Scanner *other_scanner = self->scanner;
-
-    self->scanner = Scanner__create(source);
-
-    Parser__parse_statements(self, self->parsed_source->statements);
+void Parser__parse_until_end_of_file(Parser *self, Parsed_Statements *statements) {
+    Parser__parse_statements(self, statements);
 
     Token *last_token = Parser__peek_token(self, 0);
-    if (!Token__is_end_of_file(last_token)) {
-        pWriter__begin_location_message(stderr_writer, last_token->location, WRITER_STYLE__ERROR);
+    if (!Parser__matches_one(self, Token__is_end_of_file)) {
+        pWriter__begin_location_message(stderr_writer, Parser__current_location(self), WRITER_STYLE__ERROR);
         pWriter__write__cstring(stderr_writer, "Scanner didn't reach end of file");
         pWriter__end_location_message(stderr_writer);
         panic();
-    } else if (last_token->location->column != 1) {
+    } else if (Source_Location__get_column(last_token->location) != 1) {
         pWriter__begin_location_message(stderr_writer, last_token->location, WRITER_STYLE__WARNING);
         pWriter__write__cstring(stderr_writer, "No new line at the end of file");
         pWriter__end_location_message(stderr_writer);
     }
+}
+
+typedef struct Parser_Range {
+    Source *source;
+    size_t start_index;
+    size_t end_index;
+    Parsed_Statements *statements;
+} Parser_Range;
+
+static void Parser_Range__parse(Parser_Range *self) {
+    Parser parser = {
+        .scanner = Scanner__create_range(self->source, self->start_index, self->end_index, true),
+        .parsed_source = NULL,
+        .current_identation = 0,
+        .expression_depth = 0,
+    };
+    self->statements = Parsed_Statements__create(true);
+    Parser__parse_until_end_of_file(&parser, self->statements);
+}
+
+/* Checks if the line starts with one of the top level declaration keywords */
+static bool Parser__is_declaration_line(const char *content, size_t line_index) {
+    size_t keyword_end_index = chars_skip_identifier_letters(content, line_index);
+    if (content[keyword_end_index] != ' ') {
+        return false;
+    }
+    switch (Token_Keyword__find(String_View__create(content + line_index, keyword_end_index - line_index))) {
+    case TOKEN_KEYWORD__EXTERNAL:
+    case TOKEN_KEYWORD__FUNC:
+    case TOKEN_KEYWORD__LET:
+    case TOKEN_KEYWORD__STRUCT:
+    case TOKEN_KEYWORD__TRAIT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*
+ * Top level declarations start at column 1, and nothing else that starts there continues a
+ * declaration. So the source is split before such lines in ranges of at least PARSER__CHUNK_SIZE
+ * chars, which are scanned and parsed in parallel, and their statements are joined in order.
+ * Returns false if the source has to be parsed in one go instead: when it cannot be split, or
+ * when one of the ranges failed, since only parsing in one go reports the same error.
+ */
+static bool Parser__parse_ranges(Parser *self, Source *source) {
+    const char *content = source->content;
+    size_t file_size = source->file_size;
+    size_t ranges_size = file_size / PARSER__CHUNK_SIZE + 1;
+    Parser_Range *ranges = (Parser_Range *)malloc(ranges_size * sizeof(Parser_Range));
+    Worker_Task *tasks = (Worker_Task *)malloc(ranges_size * sizeof(Worker_Task));
+    size_t ranges_count = 0;
+    size_t start_index = 0;
+    while (start_index < file_size) {
+        size_t end_index = file_size;
+        if (file_size - start_index > PARSER__CHUNK_SIZE && ranges_count + 1 < ranges_size) {
+            const char *line_end = memchr(content + start_index + PARSER__CHUNK_SIZE - 1, '\n', file_size - start_index - PARSER__CHUNK_SIZE + 1);
+            while (line_end != NULL) {
+                size_t line_index = line_end + 1 - content;
+                if (Parser__is_declaration_line(content, line_index)) {
+                    end_index = line_index;
+                    break;
+                }
+                line_end = memchr(line_end + 1, '\n', file_size - line_index);
+            }
+        }
+        ranges[ranges_count] = (Parser_Range){.source = source, .start_index = start_index, .end_index = end_index, .statements = NULL};
+        tasks[ranges_count] = (Worker_Task){.run = (void (*)(void *))Parser_Range__parse, .data = &ranges[ranges_count]};
+        ranges_count = ranges_count + 1;
+        start_index = end_index;
+    }
+
+    bool is_parsed = false;
+    if (ranges_count > 1) {
+        if (Workers__run(tasks, ranges_count)) {
+            Workers__report(tasks, ranges_count);
+            for (size_t range_index = 0; range_index < ranges_count; range_index++) {
+                Parsed_Statements *statements = ranges[range_index].statements;
+                for (uint32_t statement_index = 0; statement_index < statements->statements_count; statement_index++) {
+                    Parsed_Statements__append(self->parsed_source->statements, statements->statements[statement_index]);
+                }
+            }
+            is_parsed = true;
+        } else {
+            Workers__discard(tasks, ranges_count);
+        }
+    }
+    free(tasks);
+    free(ranges);
+    return is_parsed;
+}
+
+void Parser__parse_source(Parser *self, Source *source) {
+    if (source->file_size > PARSER__CHUNK_SIZE && Workers__count() > 1 && Parser__parse_ranges(self, source)) {
+        return;
+    }
+
+    Scanner *other_scanner = self->scanner;
+
+    self->scanner = Scanner__create(source, true);
+
+    Parser__parse_until_end_of_file(self, self->parsed_source->statements);
 
     self->scanner = other_scanner;
 }
@@ -1064,8 +1170,48 @@ Parsed_Source *parse(Source *source) {
     parser.parsed_source = Parsed_Source__create();
     parser.parsed_source->first_source = source;
     parser.current_identation = 0;
+    parser.expression_depth = 0;
 
     Parser__parse_source(&parser, source);
 
     return parser.parsed_source;
 }
+
+typedef struct Parser_Source_Task {
+    Source *source;
+    Parsed_Source *parsed_source;
+} Parser_Source_Task;
+
+static void Parser_Source_Task__parse(Parser_Source_Task *self) {
+    self->parsed_source = parse(self->source);
+}
+
+Parsed_Source *parse_sources(Source *first_source) {
+    size_t sources_count = 0;
+    for (Source *source = first_source; source != NULL; source = source->next) {
+        sources_count = sources_count + 1;
+    }
+
+    Parser_Source_Task *source_tasks = (Parser_Source_Task *)malloc(sources_count * sizeof(Parser_Source_Task));
+    Worker_Task *tasks = (Worker_Task *)malloc(sources_count * sizeof(Worker_Task));
+    size_t source_index = 0;
+    for (Source *source = first_source; source != NULL; source = source->next) {
+        source_tasks[source_index] = (Parser_Source_Task){.source = source, .parsed_source = NULL};
+        tasks[source_index] = (Worker_Task){.run = (void (*)(void *))Parser_Source_Task__parse, .data = &source_tasks[source_index]};
+        source_index = source_index + 1;
+    }
+    Workers__run(tasks, sources_count);
+    Workers__report(tasks, sources_count);
+
+    Parsed_Source *parsed_source = Parsed_Source__create();
+    parsed_source->first_source = first_source;
+    for (source_index = 0; source_index < sources_count; source_index++) {
+        Parsed_Statements *statements = source_tasks[source_index].parsed_source->statements;
+        for (uint32_t statement_index = 0; statement_index < statements->statements_count; statement_index++) {
+            Parsed_Statements__append(parsed_source->statements, statements->statements[statement_index]);
+        }
+    }
+    free(tasks);
+    free(source_tasks);
+    return parsed_source;
+}
@@ -8,4 +8,7 @@
 
 Parsed_Source *parse(Source *source);
 
+/* Parses the chained sources concurrently, and joins their statements in source order */
+Parsed_Source *parse_sources(Source *first_source);
+
 #endif
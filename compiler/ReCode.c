@@ -1,14 +1,18 @@
 /* Copyright (C) 2024 Stefan Selariu */
 
+#include "Arena.h"
 #include "Checker.h"
 #include "File.h"
 #include "Generator.h"
 #include "Parser.h"
+#include "Scanner.h"
+#include "Worker.h"
 
 void help_recode() {
     fprintf(stderr, "Available commands:\n");
     fprintf(stderr, "   \033[1mcode\033[0m    compiles whole program\n");
-    fprintf(stderr, "   \033[1mmodule\033[0m  compiles one module\n");
+    fprintf(stderr, "   \033[1mmodule\033[0m  compiles each file as a module, into its own C file\n");
+    fprintf(stderr, "   \033[1mtokens\033[0m  prints the tokens of one file\n");
 }
 
 Source *read_source_file(int32_t argc, char **argv) {
@@ -30,16 +34,128 @@ void recode_code(int32_t argc, char **argv) {
     Source *source = read_source_file(argc, argv);
     Parsed_Source *parsed_source = parse(source);
     Checked_Source *checked_source = check(parsed_source);
+    Arena__release(parse_arena);
     generate(stdout_writer, checked_source);
-    fflush(stdout);
+    pWriter__flush(stdout_writer);
+}
+
+void recode_tokens(int32_t argc, char **argv) {
+    Source *source = read_source_file(argc, argv);
+    Scanner *scanner = Scanner__create(source, false);
+    Token *token = scanner->current_token;
+    while (true) {
+        pWriter__write__location(stdout_writer, token->location);
+        pWriter__write__char(stdout_writer, ' ');
+        pWriter__write__uint64(stdout_writer, token->kind);
+        pWriter__write__char(stdout_writer, ' ');
+        if (token->kind == TOKEN_KIND__INTEGER) {
+            pWriter__write__uint64(stdout_writer, token->integer_value);
+            pWriter__write__char(stdout_writer, ' ');
+        }
+        if (token->kind != TOKEN_KIND__END_OF_LINE) {
+            pWriter__write__view(stdout_writer, Token__lexeme_view(token));
+        }
+        pWriter__end_line(stdout_writer);
+        if (token->kind == TOKEN_KIND__END_OF_FILE) {
+            break;
+        }
+        token = Scanner__next_token(scanner);
+    }
+    pWriter__flush(stdout_writer);
+}
+
+typedef struct Module {
+    Source *source;
+    String *name;
+    /* The path of the generated C file */
+    String *file_path;
+    Checked_Source *checked_source;
+} Module;
+
+FILE *create_output_file(String *file_path) {
+    FILE *file = fopen(file_path->data, "w");
+    if (file == NULL) {
+        pWriter__write__cstring(stderr_writer, "Cannot create file: ");
+        pWriter__write__string(stderr_writer, file_path);
+        pWriter__end_line(stderr_writer);
+        panic();
+    }
+    return file;
+}
+
+static void Module__generate(Module *self) {
+    FILE *file = create_output_file(self->file_path);
+    Writer *writer = File__create_writer(file, 64 * 1024);
+    generate_module(writer, self->checked_source, self->source, String__create_from("modules.h"));
+    pWriter__destroy(writer);
+    fclose(file);
 }
 
 void recode_module(int32_t argc, char **argv) {
-    fprintf(stderr, "Not implemented yet\n");
+    if (argc < 4) {
+        fprintf(stderr, "Usage: recode %s <directory> <file>...\n", argv[1]);
+        exit(1);
+    }
+
+    char *directory = argv[2];
+    size_t modules_count = (size_t)(argc - 3);
+    Module *modules = (Module *)malloc(modules_count * sizeof(Module));
+
+    /* The sources are created in order, so that their locations don't depend on the workers */
+    Source *last_source = NULL;
+    for (size_t module_index = 0; module_index < modules_count; module_index++) {
+        char *file_path = argv[module_index + 3];
+        char *file_name = strrchr(file_path, '/');
+        file_name = file_name != NULL ? file_name + 1 : file_path;
+        size_t file_name_length = strlen(file_name);
+        if (file_name_length <= 5 || strcmp(file_name + file_name_length - 5, ".code") != 0) {
+            fprintf(stderr, "Expected a .code file: %s\n", file_path);
+            exit(1);
+        }
+
+        Module *module = &modules[module_index];
+        module->name = String__append_bytes(String__create(), file_name, file_name_length - 5);
+        for (size_t other_index = 0; other_index < module_index; other_index++) {
+            if (String__equals_string(modules[other_index].name, module->name)) {
+                fprintf(stderr, "Duplicate module name: %s\n", String__end_with_zero(module->name)->data);
+                exit(1);
+            }
+        }
+        module->file_path = String__append_cstring(String__append_string(String__append_char(String__create_from(directory), '/'), module->name), ".c");
+        String__end_with_zero(module->file_path);
+        module->source = Source__create(String__create_from(file_path));
+        if (last_source != NULL) {
+            last_source->next = module->source;
+            module->source->prev = last_source;
+        }
+        last_source = module->source;
+    }
+
+    Parsed_Source *parsed_source = parse_sources(modules[0].source);
+    Checked_Source *checked_source = check(parsed_source);
+    Arena__release(parse_arena);
+
+    FILE *header_file = create_output_file(String__end_with_zero(String__append_cstring(String__create_from(directory), "/modules.h")));
+    Writer *header_writer = File__create_writer(header_file, 64 * 1024);
+    generate_module_header(header_writer, checked_source);
+    pWriter__destroy(header_writer);
+    fclose(header_file);
+
+    Worker_Task *tasks = (Worker_Task *)malloc(modules_count * sizeof(Worker_Task));
+    for (size_t module_index = 0; module_index < modules_count; module_index++) {
+        modules[module_index].checked_source = checked_source;
+        tasks[module_index] = (Worker_Task){.run = (void (*)(void *))Module__generate, .data = &modules[module_index]};
+    }
+    Workers__run(tasks, modules_count);
+    Workers__report(tasks, modules_count);
+    free(tasks);
+    free(modules);
 }
 
 int32_t main(int32_t argc, char **argv) {
     File__init();
+    Arena__init();
+    Token__init();
 
     if (argc == 1) {
         help_recode();
@@ -47,6 +163,8 @@ int32_t main(int32_t argc, char **argv) {
         recode_code(argc, argv);
     } else if (strcmp(argv[1], "module") == 0) {
         recode_module(argc, argv);
+    } else if (strcmp(argv[1], "tokens") == 0) {
+        recode_tokens(argc, argv);
     } else {
         fprintf(stderr, "Unknown command: %s\n\n", argv[1]);
         help_recode();
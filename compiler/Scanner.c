@@ -1,6 +1,7 @@
 /* Copyright (C) 2024 Stefan Selariu */
 
 #include "Scanner.h"
+#include "Arena.h"
 #include "File.h"
 #include "Char.h"
 
@@ -12,228 +13,263 @@ char Scanner__next_char(Scanner *self) {
     char next_char = Scanner__peek_char(self);
     if (next_char != '\0') {
         self->current_char_index = self->current_char_index + 1;
-        if (next_char == '\n') {
-            self->current_line = self->current_line + 1;
-            self->current_column = 1;
-        } else {
-            self->current_column = self->current_column + 1;
-        }
     }
     return next_char;
 }
 
-Token *Scanner__scan_character_token(Scanner *self, Source_Location *source_location, String *token_lexeme) {
+Token *Scanner__scan_character_token(Scanner *self, Token *token) {
     if (Scanner__next_char(self) != '\'') {
-        pWriter__begin_location_message(stderr_writer, source_location, WRITER_STYLE__ERROR);
+        pWriter__begin_location_message(stderr_writer, token->location, WRITER_STYLE__ERROR);
         pWriter__write__cstring(stderr_writer, "Unexpected char");
         pWriter__end_location_message(stderr_writer);
         panic();
     }
-    String__append_char(token_lexeme, '\'');
 
     char next_char = Scanner__peek_char(self);
     if (char_is_end_of_line(next_char) || next_char == '\t') {
-        return (Token *)Error_Token__create(source_location, token_lexeme);
+        token->kind = TOKEN_KIND__ERROR;
+        return token;
     }
 
-    String__append_char(token_lexeme, Scanner__next_char(self));
-    char value = next_char;
+    char value = Scanner__next_char(self);
 
     if (value == '\'') {
-        return (Token *)Error_Token__create(source_location, token_lexeme);
+        token->kind = TOKEN_KIND__ERROR;
+        return token;
     }
 
     if (value == '\\') {
         next_char = Scanner__peek_char(self);
         if (char_is_end_of_line(next_char) || next_char == '\t') {
-            return (Token *)Error_Token__create(source_location, token_lexeme);
+            token->kind = TOKEN_KIND__ERROR;
+            return token;
         }
 
-        String__append_char(token_lexeme, Scanner__next_char(self));
+        Scanner__next_char(self);
 
         value = escape_char_value(next_char);
         if (value == (char)-1) {
-            return (Token *)Error_Token__create(source_location, token_lexeme);
+            token->kind = TOKEN_KIND__ERROR;
+            return token;
         }
     }
 
     if (Scanner__peek_char(self) != '\'') {
-        return (Token *)Error_Token__create(source_location, token_lexeme);
+        token->kind = TOKEN_KIND__ERROR;
+        return token;
     }
 
-    String__append_char(token_lexeme, Scanner__next_char(self));
-    return (Token *)Character_Token__create(source_location, token_lexeme, value);
+    Scanner__next_char(self);
+    token->kind = TOKEN_KIND__CHARACTER;
+    token->character_value = value;
+    return token;
 }
 
-Token *Scanner__scan_comment_token(Scanner *self, Source_Location *source_location, String *token_lexeme) {
-    do {
-        String__append_char(token_lexeme, Scanner__next_char(self));
-    } while (Scanner__peek_char(self) != '\n');
-    return (Token *)Comment_Token__create(source_location, token_lexeme);
+Token *Scanner__scan_comment_token(Scanner *self, Token *token) {
+    Scanner__next_char(self);
+    self->current_char_index = chars_skip_line(self->source->content, self->current_char_index);
+    token->kind = TOKEN_KIND__COMMENT;
+    return token;
 }
 
-Token *Scanner__scan_identifier_token(Scanner *self, Source_Location *source_location, String *token_lexeme) {
-    while (char_is_identifier_letter(Scanner__peek_char(self))) {
-        String__append_char(token_lexeme, Scanner__next_char(self));
-    }
-    return (Token *)Identifier_Token__create(source_location, token_lexeme);
+Token *Scanner__scan_identifier_token(Scanner *self, Token *token) {
+    self->current_char_index = chars_skip_identifier_letters(self->source->content, self->current_char_index);
+    String_View lexeme = String_View__create(self->source->content + token->offset, self->current_char_index - token->offset);
+    token->keyword = Token_Keyword__find(lexeme);
+    token->kind = token->keyword != TOKEN_KEYWORD__NONE ? TOKEN_KIND__KEYWORD : TOKEN_KIND__IDENTIFIER;
+    token->lexeme = String__intern_view(lexeme);
+    return token;
 }
 
-Token *Scanner__scan_integer_token(Scanner *self, Source_Location *source_location, String *token_lexeme) {
+Token *Scanner__scan_integer_token(Scanner *self, Token *token) {
     uint64_t value = 0;
     if (Scanner__peek_char(self) == '0') {
-        String__append_char(token_lexeme, Scanner__next_char(self));
+        Scanner__next_char(self);
         if (Scanner__peek_char(self) == 'x') {
-            String__append_char(token_lexeme, Scanner__next_char(self));
+            Scanner__next_char(self);
             while (true) {
                 char c = Scanner__peek_char(self);
                 if (char_is_digit(c)) {
                     value = value * 16 + (c - '0');
-                    String__append_char(token_lexeme, Scanner__next_char(self));
                 } else if (c >= 'A' && c <= 'F') {
                     value = value * 16 + (c - 'A' + 10);
-                    String__append_char(token_lexeme, Scanner__next_char(self));
                 } else if (c >= 'a' && c <= 'f') {
                     value = value * 16 + (c - 'a' + 10);
-                    String__append_char(token_lexeme, Scanner__next_char(self));
-                } else if (c == '_') {
-                    String__append_char(token_lexeme, Scanner__next_char(self));
-                } else {
+                } else if (c != '_') {
                     break;
                 }
+                Scanner__next_char(self);
             }
         }
     } else {
         while (char_is_digit(Scanner__peek_char(self))) {
             char c = Scanner__next_char(self);
             value = value * 10 + (c - '0');
-            String__append_char(token_lexeme, c);
         }
     }
-    return (Token *)Integer_Token__create(source_location, token_lexeme, value);
+    token->kind = TOKEN_KIND__INTEGER;
+    token->integer_value = value;
+    return token;
 }
 
-Token *Scanner__scan_space_token(Scanner *self, Source_Location *source_location, String *token_lexeme) {
-    uint16_t count = 0;
-    while (char_is_space(Scanner__peek_char(self))) {
-        count = count + 1;
-        String__append_char(token_lexeme, Scanner__next_char(self));
-    }
-    return (Token *)Space_Token__create(source_location, token_lexeme, count);
+Token *Scanner__scan_space_token(Scanner *self, Token *token) {
+    self->current_char_index = chars_skip_spaces(self->source->content, self->current_char_index);
+    token->kind = TOKEN_KIND__SPACE;
+    return token;
 }
 
-Token *Scanner__scan_string_token(Scanner *self, Source_Location *source_location, String *token_lexeme) {
+Token *Scanner__scan_string_token(Scanner *self, Token *token) {
     if (Scanner__next_char(self) != '"') {
-        pWriter__begin_location_message(stderr_writer, source_location, WRITER_STYLE__ERROR);
+        pWriter__begin_location_message(stderr_writer, token->location, WRITER_STYLE__ERROR);
         pWriter__write__cstring(stderr_writer, "Unexpected char");
         pWriter__end_location_message(stderr_writer);
         panic();
     }
-    String__append_char(token_lexeme, '"');
-
-    String *value = String__create();
 
+    bool has_escapes = false;
     while (true) {
         char next_char = Scanner__peek_char(self);
         if (char_is_end_of_line(next_char) || next_char == '\t') {
-            return (Token *)Error_Token__create(source_location, token_lexeme);
+            token->kind = TOKEN_KIND__ERROR;
+            return token;
         }
 
-        String__append_char(token_lexeme, Scanner__next_char(self));
+        Scanner__next_char(self);
 
         if (next_char == '"') {
-            return (Token *)String_Token__create(source_location, token_lexeme, value);
+            token->kind = TOKEN_KIND__STRING;
+            token->has_escapes = has_escapes;
+            return token;
         }
 
         if (next_char == '\\') {
             next_char = Scanner__peek_char(self);
             if (char_is_end_of_line(next_char) || next_char == '\t') {
-                return (Token *)Error_Token__create(source_location, token_lexeme);
+                token->kind = TOKEN_KIND__ERROR;
+                return token;
             }
 
-            String__append_char(token_lexeme, Scanner__next_char(self));
+            Scanner__next_char(self);
 
-            next_char = escape_char_value(next_char);
-            if (next_char == ((char)-1)) {
-                return (Token *)Error_Token__create(source_location, token_lexeme);
+            if (escape_char_value(next_char) == ((char)-1)) {
+                token->kind = TOKEN_KIND__ERROR;
+                return token;
             }
+            has_escapes = true;
         }
-
-        String__append_char(value, next_char);
     }
 }
 
-Token *Scanner__scan_token(Scanner *self) {
-    Source_Location *source_location = Source_Location__create(self->source, self->current_line, self->current_column);
-    String *token_lexeme = String__create();
+Token *Scanner__scan_token_kind(Scanner *self, Token *token) {
+    if (self->current_char_index >= self->end_char_index) {
+        token->kind = TOKEN_KIND__END_OF_FILE;
+        return token;
+    }
 
     char next_char = Scanner__peek_char(self);
 
-    if (char_is_identifier_start(next_char)) {
-        return Scanner__scan_identifier_token(self, source_location, token_lexeme);
+    if (char_has_class(next_char, CHAR_CLASS__IDENTIFIER_START)) {
+        return Scanner__scan_identifier_token(self, token);
     }
 
-    if (char_is_digit(next_char)) {
-        return Scanner__scan_integer_token(self, source_location, token_lexeme);
+    if (char_has_class(next_char, CHAR_CLASS__DIGIT)) {
+        return Scanner__scan_integer_token(self, token);
     }
 
-    if (char_is_space(next_char)) {
-        return Scanner__scan_space_token(self, source_location, token_lexeme);
+    if (char_has_class(next_char, CHAR_CLASS__SPACE)) {
+        return Scanner__scan_space_token(self, token);
     }
 
     if (next_char == '\'') {
-        return Scanner__scan_character_token(self, source_location, token_lexeme);
+        return Scanner__scan_character_token(self, token);
     }
 
     if (next_char == '\"') {
-        return Scanner__scan_string_token(self, source_location, token_lexeme);
+        return Scanner__scan_string_token(self, token);
     }
 
     if (next_char == '\\') {
-        return Scanner__scan_comment_token(self, source_location, token_lexeme);
+        return Scanner__scan_comment_token(self, token);
     }
 
     if (next_char == '\n') {
-        String__append_char(token_lexeme, Scanner__next_char(self));
-        return (Token *)End_Of_Line_Token__create(source_location, token_lexeme);
+        Scanner__next_char(self);
+        token->kind = TOKEN_KIND__END_OF_LINE;
+        return token;
     }
 
     if (next_char == '\0') {
-        return (Token *)End_Of_File_Token__create(source_location, token_lexeme);
+        token->kind = TOKEN_KIND__END_OF_FILE;
+        return token;
     }
 
-    String__append_char(token_lexeme, Scanner__next_char(self));
-    return (Token *)Other_Token__create(source_location, token_lexeme);
+    token->kind = TOKEN_KIND__OTHER;
+    token->character_value = Scanner__next_char(self);
+    return token;
 }
 
-Token *Scanner__next_token(Scanner *self) {
-    if (self->current_token->next_token == NULL) {
-        self->current_token->next_token = Scanner__scan_token(self);
+void Scanner__scan_token(Scanner *self, Token *token) {
+    token->leading_spaces = 0;
+    token->comment_length = 0;
+    if (self->attaches_trivia && self->current_char_index < self->end_char_index) {
+        size_t spaces_index = self->current_char_index;
+        self->current_char_index = chars_skip_spaces(self->source->content, spaces_index);
+        token->leading_spaces = self->current_char_index - spaces_index;
+        if (Scanner__peek_char(self) == '\\') {
+            size_t comment_index = self->current_char_index;
+            self->current_char_index = chars_skip_line(self->source->content, comment_index);
+            token->comment_length = self->current_char_index - comment_index;
+        }
     }
-    self->current_token = self->current_token->next_token;
+    token->keyword = TOKEN_KEYWORD__NONE;
+    token->offset = self->current_char_index;
+    token->location = Source_Location__create(self->source, self->current_char_index);
+    token->integer_value = 0;
+    Scanner__scan_token_kind(self, token);
+    token->length = self->current_char_index - token->offset;
+}
+
+Token *Scanner__next_token(Scanner *self) {
+    self->current_token_index = (self->current_token_index + 1) % SCANNER__TOKENS_SIZE;
+    self->tokens_count = self->tokens_count - 1;
+    self->current_token = Scanner__peek_token(self, 0);
     return self->current_token;
 }
 
 Token *Scanner__peek_token(Scanner *self, uint8_t offset) {
-    Token *token = self->current_token;
-    while (offset > 0) {
-        if (token->next_token == NULL) {
-            token->next_token = Scanner__scan_token(self);
-        }
-        token = token->next_token;
-        offset = offset - 1;
+    if (offset >= SCANNER__TOKENS_SIZE - 1) {
+        pWriter__style(stderr_writer, WRITER_STYLE__ERROR);
+        pWriter__write__cstring(stderr_writer, "Lookahead too big");
+        pWriter__style(stderr_writer, WRITER_STYLE__DEFAULT);
+        pWriter__end_line(stderr_writer);
+        panic();
     }
-    return token;
+    while (self->tokens_count <= offset) {
+        Scanner__scan_token(self, &self->tokens[(self->current_token_index + self->tokens_count) % SCANNER__TOKENS_SIZE]);
+        self->tokens_count = self->tokens_count + 1;
+    }
+    return &self->tokens[(self->current_token_index + offset) % SCANNER__TOKENS_SIZE];
 }
 
-Scanner *Scanner__create(Source *source) {
-    Scanner *scanner = (Scanner *)malloc(sizeof(Scanner));
+static Scanner *Scanner__allocate(Source *source, size_t start_index, size_t end_index, bool attaches_trivia) {
+    Scanner *scanner = (Scanner *)Arena__allocate(parse_arena, sizeof(Scanner));
     scanner->source = source;
-    scanner->current_char_index = 0;
-    scanner->current_line = 1;
-    scanner->current_column = 1;
+    scanner->current_char_index = start_index;
+    scanner->end_char_index = end_index;
+    scanner->current_token_index = 0;
+    scanner->tokens_count = 0;
+    scanner->attaches_trivia = attaches_trivia;
+    return scanner;
+}
 
-    scanner->current_token = Scanner__scan_token(scanner);
+Scanner *Scanner__create(Source *source, bool attaches_trivia) {
+    Scanner *scanner = Scanner__allocate(source, 0, source->file_size, attaches_trivia);
+    scanner->current_token = Scanner__peek_token(scanner, 0);
+    return scanner;
+}
 
+Scanner *Scanner__create_range(Source *source, size_t start_index, size_t end_index, bool attaches_trivia) {
+    Scanner *scanner = Scanner__allocate(source, start_index, end_index, attaches_trivia);
+    scanner->current_token = Scanner__peek_token(scanner, 0);
     return scanner;
-}
\ No newline at end of file
+}
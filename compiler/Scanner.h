@@ -5,16 +5,29 @@
 
 #include "Token.h"
 
+/* The current token, the parser's lookahead of 3 tokens, and the last consumed token */
+#define SCANNER__TOKENS_SIZE 4
+
 typedef struct Scanner {
     Source *source;
     size_t current_char_index;
-    uint16_t current_line;
-    uint16_t current_column;
+    /* An end of file token is scanned here, unless the file ends before */
+    size_t end_char_index;
+    /* Spaces and comments are attached to the next token instead of being tokens */
+    bool attaches_trivia;
+    /* Ring buffer of scanned tokens, starting with the current token */
+    Token tokens[SCANNER__TOKENS_SIZE];
+    uint8_t current_token_index;
+    uint8_t tokens_count;
     Token *current_token;
 } Scanner;
 
-Scanner *Scanner__create(Source *source);
+Scanner *Scanner__create(Source *source, bool attaches_trivia);
+
+/* Scans only the chars between the given line starts */
+Scanner *Scanner__create_range(Source *source, size_t start_index, size_t end_index, bool attaches_trivia);
 
+/* The previous current token stays valid until the next call */
 Token *Scanner__next_token(Scanner *self);
 
 Token *Scanner__peek_token(Scanner *self, uint8_t offset);
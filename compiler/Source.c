@@ -1,43 +1,200 @@
 /* Copyright (C) 2024 Stefan Selariu */
 
 #include "Source.h"
+#include "Arena.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Maps the file read-only, followed by at least one zero byte: the kernel zero-fills the
+ * rest of the last file page, and when the file fills its last page completely, the next
+ * page comes from an anonymous mapping reserved in advance.
+ */
+static const char *Source__map_file(int file, size_t file_size) {
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t mapping_size = (file_size + 1 + page_size - 1) / page_size * page_size;
+
+    char *mapping = mmap(NULL, mapping_size, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return NULL;
+    }
+    if (mmap(mapping, file_size, PROT_READ, MAP_PRIVATE | MAP_FIXED, file, 0) == MAP_FAILED) {
+        munmap(mapping, mapping_size);
+        return NULL;
+    }
+    return mapping;
+}
+
+/*
+ * Used for pipes, terminals and anything else that cannot be mapped. The scanner loads whole
+ * aligned blocks of up to 32 bytes, so the content is 32 byte aligned, and padded with zeros up
+ * to the end of its last block.
+ */
+static const char *Source__read_file(int file, size_t *file_size) {
+    size_t content_size = 64 * 1024;
+    size_t content_length = 0;
+    char *content = (char *)aligned_alloc(32, content_size);
+    while (content != NULL) {
+        if (content_length + 1 == content_size) {
+            char *grown_content = (char *)aligned_alloc(32, content_size * 2);
+            if (grown_content != NULL) {
+                memcpy(grown_content, content, content_length);
+            }
+            free(content);
+            content = grown_content;
+            content_size = content_size * 2;
+            continue;
+        }
+        ssize_t count = read(file, content + content_length, content_size - content_length - 1);
+        if (count < 0) {
+            free(content);
+            return NULL;
+        }
+        if (count == 0) {
+            break;
+        }
+        content_length = content_length + (size_t)count;
+    }
+    if (content != NULL) {
+        /* The content size is a multiple of 32 bigger than the content length */
+        size_t padded_size = (content_length + 1 + 31) / 32 * 32;
+        memset(content + content_length, 0, padded_size - content_length); /* simplifies EOF detection */
+        *file_size = content_length;
+    }
+    return content;
+}
+
+/*
+ * All sources, ordered by their base offset. Sources are only appended, under the mutex, and the
+ * array is published before its count, so they are found without locking. A grown array is
+ * copied, and the old one is kept, since it may still be read.
+ */
+static pthread_mutex_t sources_mutex = PTHREAD_MUTEX_INITIALIZER;
+static Source **sources = NULL;
+static size_t sources_count = 0;
+static size_t sources_size = 0;
+static uint32_t next_base_offset = 1;
 
 Source *Source__create(String *file_path) {
-    FILE *file = fopen(file_path->data, "r");
-    if (file == NULL) {
+    int file = open(file_path->data, O_RDONLY);
+    if (file < 0) {
         fprintf(stderr, "Could not open file: %s\n", file_path->data);
         panic();
     }
 
-    fseek(file, 0, SEEK_END);
-    size_t file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
-
-    char *content = malloc(file_size + 1);
-    if (content == NULL) {
+    struct stat file_stat;
+    if (fstat(file, &file_stat) != 0) {
         fprintf(stderr, "Failed to read file: %s\n", file_path->data);
         panic();
     }
 
-    if (fread(content, 1, file_size, file) != file_size) {
+    size_t file_size = 0;
+    const char *content = NULL;
+    if (S_ISREG(file_stat.st_mode) && file_stat.st_size > 0) {
+        file_size = (size_t)file_stat.st_size;
+        content = Source__map_file(file, file_size);
+    }
+    if (content == NULL) {
+        content = Source__read_file(file, &file_size);
+    }
+    if (content == NULL) {
         fprintf(stderr, "Failed to read file: %s\n", file_path->data);
         panic();
     }
-    content[file_size] = '\0'; /* simplifies EOF detection */
 
-    fclose(file);
+    close(file);
 
-    Source *source = malloc(sizeof(Source));
-    if (source == NULL) {
-        fprintf(stderr, "Failed to create source: %s\n", file_path->data);
+    pthread_mutex_lock(&sources_mutex);
+    if (file_size >= UINT32_MAX - next_base_offset) {
+        pthread_mutex_unlock(&sources_mutex);
+        fprintf(stderr, "Too much source code: %s\n", file_path->data);
         panic();
     }
 
+    Source *source = (Source *)Arena__allocate(source_arena, sizeof(Source));
     source->content = content;
     source->file_path = file_path;
     source->file_size = file_size;
+    source->base_offset = next_base_offset;
+    source->line_offsets = NULL;
+    source->lines_count = 0;
     source->next = NULL;
     source->prev = NULL;
 
+    /* The end of file gets a location too */
+    next_base_offset = next_base_offset + (uint32_t)file_size + 1;
+    if (sources_count == sources_size) {
+        sources_size = sources_size == 0 ? 8 : sources_size * 2;
+        Source **new_sources = (Source **)malloc(sources_size * sizeof(Source *));
+        if (sources_count > 0) {
+            memcpy(new_sources, sources, sources_count * sizeof(Source *));
+        }
+        __atomic_store_n(&sources, new_sources, __ATOMIC_RELEASE);
+    }
+    sources[sources_count] = source;
+    __atomic_store_n(&sources_count, sources_count + 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&sources_mutex);
+
     return source;
 }
+
+Source *Source__find(uint32_t location) {
+    size_t high = __atomic_load_n(&sources_count, __ATOMIC_ACQUIRE);
+    Source **found_sources = __atomic_load_n(&sources, __ATOMIC_ACQUIRE);
+    size_t low = 0;
+    while (high - low > 1) {
+        size_t middle = low + (high - low) / 2;
+        if (found_sources[middle]->base_offset <= location) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return found_sources[low];
+}
+
+static void Source__build_line_offsets(Source *self) {
+    pthread_mutex_lock(&sources_mutex);
+    if (self->line_offsets != NULL) {
+        pthread_mutex_unlock(&sources_mutex);
+        return;
+    }
+    uint32_t lines_size = 1024;
+    uint32_t *line_offsets = (uint32_t *)malloc(lines_size * sizeof(uint32_t));
+    uint32_t lines_count = 0;
+    line_offsets[lines_count++] = 0;
+    const char *content_end = self->content + self->file_size;
+    const char *line_end = memchr(self->content, '\n', self->file_size);
+    while (line_end != NULL) {
+        if (lines_count == lines_size) {
+            lines_size = lines_size * 2;
+            line_offsets = (uint32_t *)realloc(line_offsets, lines_size * sizeof(uint32_t));
+        }
+        line_offsets[lines_count++] = (uint32_t)(line_end + 1 - self->content);
+        line_end = memchr(line_end + 1, '\n', content_end - line_end - 1);
+    }
+    self->lines_count = lines_count;
+    __atomic_store_n(&self->line_offsets, line_offsets, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&sources_mutex);
+}
+
+uint32_t Source__get_line_index(Source *self, uint32_t offset) {
+    if (__atomic_load_n(&self->line_offsets, __ATOMIC_ACQUIRE) == NULL) {
+        Source__build_line_offsets(self);
+    }
+    uint32_t low = 0;
+    uint32_t high = self->lines_count;
+    while (high - low > 1) {
+        uint32_t middle = low + (high - low) / 2;
+        if (self->line_offsets[middle] <= offset) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
@@ -6,9 +6,15 @@
 #include "String.h"
 
 typedef struct Source {
-    char *content;
+    /* Zero terminated, and readable up to the next 32 byte boundary after the terminator */
+    const char *content;
     String *file_path;
     size_t file_size;
+    /* The location of the first char */
+    uint32_t base_offset;
+    /* The offsets where lines start, built on the first lookup */
+    uint32_t *line_offsets;
+    uint32_t lines_count;
 
     struct Source *next;
     struct Source *prev;
@@ -16,4 +22,9 @@ typedef struct Source {
 
 Source *Source__create(String *file_path);
 
+/* Returns the source that contains the given location */
+Source *Source__find(uint32_t location);
+
+uint32_t Source__get_line_index(Source *self, uint32_t offset);
+
 #endif
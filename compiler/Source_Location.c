@@ -3,24 +3,52 @@
 #include "Source_Location.h"
 #include "File.h"
 
-Source_Location *Source_Location__create(Source *source, uint16_t line, uint16_t column) {
-    Source_Location *source_location = (Source_Location *)malloc(sizeof(Source_Location));
-    source_location->source = source;
-    source_location->line = line;
-    source_location->column = column;
-    return source_location;
+Source_Location Source_Location__create(Source *source, size_t offset) {
+    return source->base_offset + (Source_Location)offset;
 }
 
-Writer *pWriter__write__location(Writer *writer, Source_Location *location) {
-    pWriter__write__string(writer, location->source->file_path);
+Source *Source_Location__get_source(Source_Location self) {
+    if (self == SOURCE_LOCATION__NONE) {
+        return NULL;
+    }
+    return Source__find(self);
+}
+
+uint32_t Source_Location__get_line(Source_Location self) {
+    if (self == SOURCE_LOCATION__NONE) {
+        return 0;
+    }
+    Source *source = Source__find(self);
+    return Source__get_line_index(source, self - source->base_offset) + 1;
+}
+
+uint32_t Source_Location__get_column(Source_Location self) {
+    if (self == SOURCE_LOCATION__NONE) {
+        return 0;
+    }
+    Source *source = Source__find(self);
+    uint32_t offset = self - source->base_offset;
+    uint32_t line_index = Source__get_line_index(source, offset);
+    return offset - source->line_offsets[line_index] + 1;
+}
+
+Writer *pWriter__write__location(Writer *writer, Source_Location location) {
+    /* Builtin types and members have no location */
+    if (location == SOURCE_LOCATION__NONE) {
+        return pWriter__write__cstring(writer, "<builtin>");
+    }
+    Source *source = Source__find(location);
+    uint32_t offset = location - source->base_offset;
+    uint32_t line_index = Source__get_line_index(source, offset);
+    pWriter__write__string(writer, source->file_path);
     pWriter__write__char(writer, ':');
-    pWriter__write__uint64(writer, location->line);
+    pWriter__write__uint64(writer, line_index + 1);
     pWriter__write__char(writer, ':');
-    pWriter__write__uint64(writer, location->column);
+    pWriter__write__uint64(writer, offset - source->line_offsets[line_index] + 1);
     return writer;
 }
 
-Writer *pWriter__begin_location_message(Writer *writer, Source_Location *location, Writer_Style style) {
+Writer *pWriter__begin_location_message(Writer *writer, Source_Location location, Writer_Style style) {
     pWriter__write__location(writer, location);
     pWriter__write__cstring(writer, ": ");
     pWriter__style(writer, style);
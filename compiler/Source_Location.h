@@ -7,17 +7,26 @@
 #include "String.h"
 #include "Writer.h"
 
-typedef struct Source_Location {
-    Source *source;
-    uint16_t line;
-    uint16_t column;
-} Source_Location;
+/*
+ * All sources share one address space, each one starting at its base offset.
+ * A location is the address of a char in that space, and 0 is no location.
+ */
+typedef uint32_t Source_Location;
 
-Source_Location *Source_Location__create(Source *source, uint16_t line, uint16_t column);
+#define SOURCE_LOCATION__NONE 0
 
-Writer *pWriter__write__location(Writer *self, Source_Location *location);
+Source_Location Source_Location__create(Source *source, size_t offset);
 
-Writer *pWriter__begin_location_message(Writer *writer, Source_Location *location, Writer_Style style);
+Source *Source_Location__get_source(Source_Location self);
+
+/* The line and column are 0 for no location */
+uint32_t Source_Location__get_line(Source_Location self);
+
+uint32_t Source_Location__get_column(Source_Location self);
+
+Writer *pWriter__write__location(Writer *self, Source_Location location);
+
+Writer *pWriter__begin_location_message(Writer *writer, Source_Location location, Writer_Style style);
 
 Writer *pWriter__end_location_message(Writer *writer);
 
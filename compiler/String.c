@@ -2,11 +2,26 @@
 
 #include "String.h"
 
+#include <pthread.h>
+
+#define STRING__INLINE_DATA_SIZE 64
+
+static bool String__has_inline_data(String *self) {
+    return self->data == (char *)(self + 1);
+}
+
 String *String__create_empty(size_t data_size) {
-    String *string = (String *)malloc(sizeof(String));
-    string->data = (char *)malloc(data_size);
+    String *string;
+    if (data_size <= STRING__INLINE_DATA_SIZE) {
+        string = (String *)malloc(sizeof(String) + data_size);
+        string->data = (char *)(string + 1);
+    } else {
+        string = (String *)malloc(sizeof(String));
+        string->data = (char *)malloc(data_size);
+    }
     string->data_size = data_size;
     string->length = 0;
+    string->hash = 0;
     return string;
 }
 
@@ -15,38 +30,48 @@ String *String__create() {
 }
 
 void String__delete(String *self) {
-    free((void *)self->data);
+    if (!String__has_inline_data(self)) {
+        free((void *)self->data);
+    }
     free((void *)self);
 }
 
+/* Grows the data geometrically, so appending stays linear */
+static void String__reserve(String *self, size_t data_size) {
+    size_t new_data_size = self->data_size < 16 ? 16 : self->data_size * 2;
+    if (new_data_size < data_size) {
+        new_data_size = data_size;
+    }
+    if (String__has_inline_data(self)) {
+        char *data = (char *)malloc(new_data_size);
+        memcpy(data, self->data, self->length);
+        self->data = data;
+    } else {
+        self->data = (char *)realloc((void *)self->data, new_data_size);
+    }
+    self->data_size = new_data_size;
+}
+
 String *String__append_char(String *self, char ch) {
     if (self->length >= self->data_size) {
-        self->data_size = self->data_size + 16;
-        self->data = (char *)realloc((void *)self->data, self->data_size);
+        String__reserve(self, self->length + 1);
     }
     self->data[self->length] = ch;
     self->length = self->length + 1;
     return self;
 }
 
-String *String__append_cstring(String *self, char *cstring) {
-    while (*cstring) {
-        String__append_char(self, *cstring);
-        cstring++;
+String *String__append_bytes(String *self, const char *bytes, size_t length) {
+    if (self->length + length > self->data_size) {
+        String__reserve(self, self->length + length);
     }
+    memcpy(self->data + self->length, bytes, length);
+    self->length = self->length + length;
     return self;
 }
 
-size_t cstring_length(char *s) {
-    size_t length = 0;
-    while (true) {
-        uint8_t c = s[length];
-        if (c == 0) {
-            break;
-        }
-        length = length + 1;
-    }
-    return length;
+String *String__append_cstring(String *self, char *cstring) {
+    return String__append_bytes(self, cstring, strlen(cstring));
 }
 
 String *String__create_copy(String *other) {
@@ -55,11 +80,35 @@ String *String__create_copy(String *other) {
     return string;
 }
 
+static String *String__create_data_copy_in(const char *data, size_t length, Arena *arena) {
+    String *string = (String *)Arena__allocate(arena, sizeof(String) + length + 1);
+    string->data = (char *)(string + 1);
+    memcpy(string->data, data, length);
+    string->data[length] = '\0';
+    string->data_size = length + 1;
+    string->length = length;
+    string->hash = 0;
+    return string;
+}
+
+String *String__create_slice_in(const char *data, size_t length, Arena *arena) {
+    String *string = (String *)Arena__allocate(arena, sizeof(String));
+    string->data = (char *)data;
+    string->data_size = 0;
+    string->length = length;
+    string->hash = 0;
+    return string;
+}
+
+String *String__create_copy_in(String *other, Arena *arena) {
+    return String__create_data_copy_in(other->data, other->length, arena);
+}
+
 String *String__create_from(char *data) {
-    size_t string_length = cstring_length(data);
+    size_t string_length = strlen(data);
     String *string = String__create_empty(string_length + 1);
-    String__append_cstring(string, data);
-    return string;
+    String__append_bytes(string, data, string_length);
+    return String__end_with_zero(string);
 }
 
 String *String__append_int16_t(String *self, int16_t value) {
@@ -76,12 +125,7 @@ String *String__append_int16_t(String *self, int16_t value) {
 }
 
 String *String__append_string(String *self, String *other) {
-    size_t index = 0;
-    while (index < other->length) {
-        String__append_char(self, other->data[index]);
-        index = index + 1;
-    }
-    return self;
+    return String__append_bytes(self, other->data, other->length);
 }
 
 String *String__end_with_zero(String *self) {
@@ -91,43 +135,133 @@ String *String__end_with_zero(String *self) {
 }
 
 bool String__equals_cstring(String *self, char *s) {
-    size_t length = cstring_length(s);
-    if (self->length != length) {
-        return false;
+    return String_View__equals_cstring(String__view(self), s);
+}
+
+bool String__equals_string(String *self, String *other) {
+    return String_View__equals(String__view(self), String__view(other));
+}
+
+Writer *pWriter__write__string(Writer *self, String *string) {
+    return pWriter__write__bytes(self, string->data, string->length);
+}
+
+String_View String_View__create(const char *data, size_t length) {
+    return (String_View){.data = data, .length = length};
+}
+
+String_View String_View__from_cstring(const char *cstring) {
+    return String_View__create(cstring, strlen(cstring));
+}
+
+String_View String__view(String *self) {
+    return String_View__create(self->data, self->length);
+}
+
+bool String_View__equals(String_View self, String_View other) {
+    return self.length == other.length && memcmp(self.data, other.data, self.length) == 0;
+}
+
+bool String_View__equals_cstring(String_View self, const char *cstring) {
+    return String_View__equals(self, String_View__from_cstring(cstring));
+}
+
+Writer *pWriter__write__view(Writer *self, String_View view) {
+    return pWriter__write__bytes(self, view.data, view.length);
+}
+
+static void string_write_bytes(String *string, const char *bytes, size_t length) {
+    String__append_bytes(string, bytes, length);
+}
+
+Writer *String__create_writer(String *self) {
+    return Writer__create(self, (void (*)(void *, const char *, size_t))string_write_bytes, 4 * 1024);
+}
+
+/*
+ * Strings are interned from worker threads too. The table is split by hash in shards with their
+ * own lock, so that workers scanning different sources rarely wait for each other.
+ */
+#define STRING__INTERNED_SHARDS_BITS 6
+#define STRING__INTERNED_SHARDS_COUNT (1 << STRING__INTERNED_SHARDS_BITS)
+
+typedef struct Interned_Strings_Shard {
+    pthread_mutex_t mutex;
+    String **strings;
+    size_t strings_size;
+    size_t strings_count;
+} Interned_Strings_Shard;
+
+static Interned_Strings_Shard interned_strings_shards[STRING__INTERNED_SHARDS_COUNT] = {
+    [0 ... STRING__INTERNED_SHARDS_COUNT - 1] = {.mutex = PTHREAD_MUTEX_INITIALIZER},
+};
+
+static uint32_t data_hash(const char *data, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t index = 0; index < length; index++) {
+        hash = (hash ^ (uint8_t)data[index]) * 16777619u;
     }
+    return hash;
+}
 
-    size_t index = 0;
-    while (index < length) {
-        if (self->data[index] != s[index]) {
-            return false;
+static void Interned_Strings_Shard__grow(Interned_Strings_Shard *self) {
+    size_t old_size = self->strings_size;
+    String **old_strings = self->strings;
+
+    self->strings_size = old_size == 0 ? 64 : old_size * 2;
+    self->strings = (String **)calloc(self->strings_size, sizeof(String *));
+    for (size_t old_index = 0; old_index < old_size; old_index++) {
+        String *string = old_strings[old_index];
+        if (string != NULL) {
+            size_t index = string->hash & (self->strings_size - 1);
+            while (self->strings[index] != NULL) {
+                index = (index + 1) & (self->strings_size - 1);
+            }
+            self->strings[index] = string;
         }
-        index = index + 1;
     }
-
-    return true;
+    free(old_strings);
 }
 
-bool String__equals_string(String *self, String *other) {
-    if (self->length != other->length) {
-        return false;
+String *String__intern_view(String_View view) {
+    uint32_t hash = data_hash(view.data, view.length);
+    /* The high bits pick the shard, and the low bits the slot in it */
+    Interned_Strings_Shard *shard = &interned_strings_shards[hash >> (32 - STRING__INTERNED_SHARDS_BITS)];
+
+    pthread_mutex_lock(&shard->mutex);
+    if ((shard->strings_count + 1) * 2 > shard->strings_size) {
+        Interned_Strings_Shard__grow(shard);
     }
 
-    size_t index = 0;
-    while (index < self->length) {
-        if (self->data[index] != other->data[index]) {
-            return false;
+    size_t index = hash & (shard->strings_size - 1);
+    while (true) {
+        String *string = shard->strings[index];
+        if (string == NULL) {
+            break;
         }
-        index = index + 1;
+        if (string->hash == hash && String_View__equals(String__view(string), view)) {
+            pthread_mutex_unlock(&shard->mutex);
+            return string;
+        }
+        index = (index + 1) & (shard->strings_size - 1);
     }
 
-    return true;
+    String *string = String__create_data_copy_in(view.data, view.length, source_arena);
+    string->hash = hash;
+    shard->strings[index] = string;
+    shard->strings_count = shard->strings_count + 1;
+    pthread_mutex_unlock(&shard->mutex);
+    return string;
 }
 
-Writer *pWriter__write__string(Writer *self, String *string) {
-    size_t index = 0;
-    while (index < string->length) {
-        self->write_char(self->object, string->data[index]);
-        index = index + 1;
-    }
-    return self;
+String *String__intern(String *other) {
+    return String__intern_view(String__view(other));
+}
+
+String *String__intern_cstring(char *cstring) {
+    return String__intern_view(String_View__from_cstring(cstring));
+}
+
+size_t String__interned_hash(String *self) {
+    return (size_t)(((uintptr_t)self >> 3) * 2654435761u);
 }
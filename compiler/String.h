@@ -3,27 +3,57 @@
 #ifndef __STRING_H__
 #define __STRING_H__
 
+#include "Arena.h"
 #include "Builtins.h"
 #include "Writer.h"
 
+/* Strings created with a small size keep their data in the same allocation, until they outgrow it */
 typedef struct String {
     char *data;
     size_t data_size;
     size_t length;
+    /* Only set for interned strings */
+    uint32_t hash;
 } String;
 
+/* Refers to chars owned by someone else, like the source content or a string */
+typedef struct String_View {
+    const char *data;
+    size_t length;
+} String_View;
+
+String_View String_View__create(const char *data, size_t length);
+
+String_View String_View__from_cstring(const char *cstring);
+
+String_View String__view(String *self);
+
+bool String_View__equals(String_View self, String_View other);
+
+bool String_View__equals_cstring(String_View self, const char *cstring);
+
+Writer *pWriter__write__view(Writer *self, String_View view);
+
 String *String__create();
 
 String *String__create_copy(String *other);
 
+/* Creates a copy that lives as long as the arena; it must not be appended to or deleted */
+String *String__create_copy_in(String *other, Arena *arena);
+
 String *String__create_empty(size_t data_size);
 
 String *String__create_from(char *data);
 
+/* Creates a string that refers to the data without copying it; it must not be appended to or deleted */
+String *String__create_slice_in(const char *data, size_t length, Arena *arena);
+
 void String__delete(String *self);
 
 String *String__append_char(String *self, char ch);
 
+String *String__append_bytes(String *self, const char *bytes, size_t length);
+
 String *String__append_cstring(String *self, char *s);
 
 String *String__append_int16_t(String *self, int16_t value);
@@ -36,6 +66,19 @@ bool String__equals_cstring(String *self, char *s);
 
 bool String__equals_string(String *self, String *other);
 
+/* Returns the canonical copy of the string, so interned strings can be compared by pointer */
+String *String__intern(String *other);
+
+String *String__intern_view(String_View view);
+
+String *String__intern_cstring(char *cstring);
+
+/* Cheap hash for interned strings, which are identified by their address */
+size_t String__interned_hash(String *self);
+
 Writer *pWriter__write__string(Writer *self, String *string);
 
+/* Creates a writer that appends to the string; it must be flushed before the string is read */
+Writer *String__create_writer(String *self);
+
 #endif
@@ -1,62 +1,116 @@
 /* Copyright (C) 2024 Stefan Selariu */
 
 #include "Token.h"
+#include "Arena.h"
+#include "Char.h"
 
-Token *Token__create_kind(Token_Kind kind, size_t kind_size, Source_Location *location, String *lexeme) {
-    Token *token = (Token *)malloc(kind_size);
-    token->kind = kind;
-    token->location = location;
-    token->lexeme = lexeme;
-    token->next_token = NULL;
+Token *Token__create_copy(Token *other) {
+    Token *token = (Token *)Arena__allocate(parse_arena, sizeof(Token));
+    *token = *other;
     return token;
 }
 
-Character_Token *Character_Token__create(Source_Location *location, String *lexeme, char value) {
-    Character_Token *token = (Character_Token *)Token__create_kind(TOKEN_KIND__CHARACTER, sizeof(Character_Token), location, lexeme);
-    token->value = value;
-    return token;
-}
-
-Comment_Token *Comment_Token__create(Source_Location *location, String *lexeme) {
-    return (Comment_Token *)Token__create_kind(TOKEN_KIND__COMMENT, sizeof(Comment_Token), location, lexeme);
-}
-
-End_Of_File_Token *End_Of_File_Token__create(Source_Location *location, String *lexeme) {
-    return (End_Of_File_Token *)Token__create_kind(TOKEN_KIND__END_OF_FILE, sizeof(End_Of_File_Token), location, lexeme);
-}
-
-End_Of_Line_Token *End_Of_Line_Token__create(Source_Location *location, String *lexeme) {
-    return (End_Of_Line_Token *)Token__create_kind(TOKEN_KIND__END_OF_LINE, sizeof(End_Of_Line_Token), location, lexeme);
-}
-
-Error_Token *Error_Token__create(Source_Location *location, String *lexeme) {
-    return (Error_Token *)Token__create_kind(TOKEN_KIND__ERROR, sizeof(Error_Token), location, lexeme);
-}
-
-Identifier_Token *Identifier_Token__create(Source_Location *location, String *lexeme) {
-    return (Identifier_Token *)Token__create_kind(TOKEN_KIND__IDENTIFIER, sizeof(Identifier_Token), location, lexeme);
-}
-
-Integer_Token *Integer_Token__create(Source_Location *location, String *lexeme, uint64_t value) {
-    Integer_Token *token = (Integer_Token *)Token__create_kind(TOKEN_KIND__INTEGER, sizeof(Integer_Token), location, lexeme);
-    token->value = value;
-    return token;
+typedef struct Keyword_Entry {
+    char *lexeme;
+    Token_Keyword keyword;
+} Keyword_Entry;
+
+static char *keyword_lexemes[] = {
+    [TOKEN_KEYWORD__AND] = "and",
+    [TOKEN_KEYWORD__ANON] = "anon",
+    [TOKEN_KEYWORD__AS] = "as",
+    [TOKEN_KEYWORD__BREAK] = "break",
+    [TOKEN_KEYWORD__ELSE] = "else",
+    [TOKEN_KEYWORD__ENUM] = "enum",
+    [TOKEN_KEYWORD__EXTERN] = "extern",
+    [TOKEN_KEYWORD__EXTERNAL] = "external",
+    [TOKEN_KEYWORD__FALSE] = "false",
+    [TOKEN_KEYWORD__FUNC] = "func",
+    [TOKEN_KEYWORD__IF] = "if",
+    [TOKEN_KEYWORD__LET] = "let",
+    [TOKEN_KEYWORD__LOOP] = "loop",
+    [TOKEN_KEYWORD__MAKE] = "make",
+    [TOKEN_KEYWORD__NOT] = "not",
+    [TOKEN_KEYWORD__NULL] = "null",
+    [TOKEN_KEYWORD__OR] = "or",
+    [TOKEN_KEYWORD__RETURN] = "return",
+    [TOKEN_KEYWORD__SIZEOF] = "sizeof",
+    [TOKEN_KEYWORD__STRUCT] = "struct",
+    [TOKEN_KEYWORD__TRAIT] = "trait",
+    [TOKEN_KEYWORD__TRUE] = "true",
+    [TOKEN_KEYWORD__TYPE] = "type",
+    [TOKEN_KEYWORD__TYPEDEF] = "typedef",
+    [TOKEN_KEYWORD__WHILE] = "while",
+};
+
+#define KEYWORD_LEXEMES_COUNT (sizeof(keyword_lexemes) / sizeof(keyword_lexemes[0]))
+
+/* Perfect hash table, indexed by (2 * lexeme[0] + 3 * lexeme[1] + length) % 64 */
+static Keyword_Entry keyword_entries[64];
+static size_t keyword_min_length = 0;
+static size_t keyword_max_length = 0;
+
+static size_t Keyword_Entry__index(const char *lexeme, size_t length) {
+    return (2 * (uint8_t)lexeme[0] + 3 * (uint8_t)lexeme[1] + length) & 63;
+}
+
+void Token__init() {
+    for (size_t keyword = TOKEN_KEYWORD__NONE + 1; keyword < KEYWORD_LEXEMES_COUNT; keyword++) {
+        char *lexeme = keyword_lexemes[keyword];
+        if (lexeme == NULL) {
+            fprintf(stderr, "Keyword without lexeme: %zu\n", keyword);
+            panic();
+        }
+        size_t length = strlen(lexeme);
+        Keyword_Entry *entry = &keyword_entries[Keyword_Entry__index(lexeme, length)];
+        /* A new keyword may need another hash */
+        if (entry->lexeme != NULL) {
+            fprintf(stderr, "Keywords with the same hash: %s, %s\n", entry->lexeme, lexeme);
+            panic();
+        }
+        entry->lexeme = lexeme;
+        entry->keyword = (Token_Keyword)keyword;
+        if (keyword_min_length == 0 || length < keyword_min_length) {
+            keyword_min_length = length;
+        }
+        if (length > keyword_max_length) {
+            keyword_max_length = length;
+        }
+    }
 }
 
-Other_Token *Other_Token__create(Source_Location *location, String *lexeme) {
-    return (Other_Token *)Token__create_kind(TOKEN_KIND__OTHER, sizeof(Other_Token), location, lexeme);
+Token_Keyword Token_Keyword__find(String_View lexeme) {
+    if (lexeme.length < keyword_min_length || lexeme.length > keyword_max_length) {
+        return TOKEN_KEYWORD__NONE;
+    }
+    Keyword_Entry *entry = &keyword_entries[Keyword_Entry__index(lexeme.data, lexeme.length)];
+    if (entry->lexeme == NULL || !String_View__equals_cstring(lexeme, entry->lexeme)) {
+        return TOKEN_KEYWORD__NONE;
+    }
+    return entry->keyword;
 }
 
-Space_Token *Space_Token__create(Source_Location *location, String *lexeme, uint16_t count) {
-    Space_Token *token = (Space_Token *)Token__create_kind(TOKEN_KIND__SPACE, sizeof(Space_Token), location, lexeme);
-    token->count = count;
-    return token;
+String_View Token__lexeme_view(Token *self) {
+    return String_View__create(Source_Location__get_source(self->location)->content + self->offset, self->length);
 }
 
-String_Token *String_Token__create(Source_Location *location, String *lexeme, String *value) {
-    String_Token *token = (String_Token *)Token__create_kind(TOKEN_KIND__STRING, sizeof(String_Token), location, lexeme);
-    token->value = value;
-    return token;
+String *Token__create_string_value(Token *self) {
+    /* The lexeme is enclosed in double quotes */
+    const char *data = Token__lexeme_view(self).data + 1;
+    size_t length = self->length - 2;
+    if (!self->has_escapes) {
+        return String__create_slice_in(data, length, source_arena);
+    }
+    String *value = String__create_empty(length);
+    for (size_t index = 0; index < length; index++) {
+        char c = data[index];
+        if (c == '\\') {
+            index = index + 1;
+            c = escape_char_value(data[index]);
+        }
+        String__append_char(value, c);
+    }
+    return value;
 }
 
 bool Token__is_anything(Token *self) {
@@ -80,215 +134,216 @@ bool Token__is_end_of_line(Token *self) {
 }
 
 bool Token__is_identifier(Token *self) {
-    return self->kind == TOKEN_KIND__IDENTIFIER;
+    /* Keywords are contextual, so they can still be used as names */
+    return self->kind == TOKEN_KIND__IDENTIFIER || self->kind == TOKEN_KIND__KEYWORD;
 }
 
 bool Token__is_integer(Token *self) {
     return self->kind == TOKEN_KIND__INTEGER;
 }
 
-bool Token__is_keyword(Token *self, char *lexeme) {
-    return self->kind == TOKEN_KIND__IDENTIFIER && String__equals_cstring(self->lexeme, lexeme);
+bool Token__is_keyword(Token *self, Token_Keyword keyword) {
+    return self->kind == TOKEN_KIND__KEYWORD && self->keyword == keyword;
 }
 
 bool Token__is_and(Token *self) {
-    return Token__is_keyword(self, "and");
+    return Token__is_keyword(self, TOKEN_KEYWORD__AND);
 }
 
 bool Token__is_anon(Token *self) {
-    return Token__is_keyword(self, "anon");
+    return Token__is_keyword(self, TOKEN_KEYWORD__ANON);
 }
 
 bool Token__is_as(Token *self) {
-    return Token__is_keyword(self, "as");
+    return Token__is_keyword(self, TOKEN_KEYWORD__AS);
 }
 
 bool Token__is_break(Token *self) {
-    return Token__is_keyword(self, "break");
+    return Token__is_keyword(self, TOKEN_KEYWORD__BREAK);
 }
 
 bool Token__is_else(Token *self) {
-    return Token__is_keyword(self, "else");
+    return Token__is_keyword(self, TOKEN_KEYWORD__ELSE);
 }
 
 bool Token__is_enum(Token *self) {
-    return Token__is_keyword(self, "enum");
+    return Token__is_keyword(self, TOKEN_KEYWORD__ENUM);
 }
 
 bool Token__is_extern(Token *self) {
-    return Token__is_keyword(self, "extern");
+    return Token__is_keyword(self, TOKEN_KEYWORD__EXTERN);
 }
 
 bool Token__is_external(Token *self) {
-    return Token__is_keyword(self, "external");
+    return Token__is_keyword(self, TOKEN_KEYWORD__EXTERNAL);
 }
 
 bool Token__is_false(Token *self) {
-    return Token__is_keyword(self, "false");
+    return Token__is_keyword(self, TOKEN_KEYWORD__FALSE);
 }
 
 bool Token__is_func(Token *self) {
-    return Token__is_keyword(self, "func");
+    return Token__is_keyword(self, TOKEN_KEYWORD__FUNC);
 }
 
 bool Token__is_if(Token *self) {
-    return Token__is_keyword(self, "if");
+    return Token__is_keyword(self, TOKEN_KEYWORD__IF);
 }
 
 bool Token__is_let(Token *self) {
-    return Token__is_keyword(self, "let");
+    return Token__is_keyword(self, TOKEN_KEYWORD__LET);
 }
 
 bool Token__is_loop(Token *self) {
-    return Token__is_keyword(self, "loop");
+    return Token__is_keyword(self, TOKEN_KEYWORD__LOOP);
 }
 
 bool Token__is_make(Token *self) {
-    return Token__is_keyword(self, "make");
+    return Token__is_keyword(self, TOKEN_KEYWORD__MAKE);
 }
 
 bool Token__is_not(Token *self) {
-    return Token__is_keyword(self, "not");
+    return Token__is_keyword(self, TOKEN_KEYWORD__NOT);
 }
 
 bool Token__is_null(Token *self) {
-    return Token__is_keyword(self, "null");
+    return Token__is_keyword(self, TOKEN_KEYWORD__NULL);
 }
 
 bool Token__is_or(Token *self) {
-    return Token__is_keyword(self, "or");
+    return Token__is_keyword(self, TOKEN_KEYWORD__OR);
 }
 
 bool Token__is_return(Token *self) {
-    return Token__is_keyword(self, "return");
+    return Token__is_keyword(self, TOKEN_KEYWORD__RETURN);
 }
 
 bool Token__is_sizeof(Token *self) {
-    return Token__is_keyword(self, "sizeof");
+    return Token__is_keyword(self, TOKEN_KEYWORD__SIZEOF);
 }
 
 bool Token__is_struct(Token *self) {
-    return Token__is_keyword(self, "struct");
+    return Token__is_keyword(self, TOKEN_KEYWORD__STRUCT);
 }
 
 bool Token__is_trait(Token *self) {
-    return Token__is_keyword(self, "trait");
+    return Token__is_keyword(self, TOKEN_KEYWORD__TRAIT);
 }
 
 bool Token__is_true(Token *self) {
-    return Token__is_keyword(self, "true");
+    return Token__is_keyword(self, TOKEN_KEYWORD__TRUE);
 }
 
 bool Token__is_type(Token *self) {
-    return Token__is_keyword(self, "type");
+    return Token__is_keyword(self, TOKEN_KEYWORD__TYPE);
 }
 
 bool Token__is_typedef(Token *self) {
-    return Token__is_keyword(self, "typedef");
+    return Token__is_keyword(self, TOKEN_KEYWORD__TYPEDEF);
 }
 
 bool Token__is_while(Token *self) {
-    return Token__is_keyword(self, "while");
+    return Token__is_keyword(self, TOKEN_KEYWORD__WHILE);
 }
 
-bool Token__is_other(Token *self, char *lexeme) {
-    return self->kind == TOKEN_KIND__OTHER && String__equals_cstring(self->lexeme, lexeme);
+bool Token__is_other(Token *self, char lexeme) {
+    return self->kind == TOKEN_KIND__OTHER && self->character_value == lexeme;
 }
 
 bool Token__is_ampersand(Token *self) {
-    return Token__is_other(self, "&");
+    return Token__is_other(self, '&');
 }
 
 bool Token__is_asterisk(Token *self) {
-    return Token__is_other(self, "*");
+    return Token__is_other(self, '*');
 }
 
 bool Token__is_at(Token *self) {
-    return Token__is_other(self, "@");
+    return Token__is_other(self, '@');
 }
 
 bool Token__is_closing_brace(Token *self) {
-    return Token__is_other(self, "}");
+    return Token__is_other(self, '}');
 }
 
 bool Token__is_closing_bracket(Token *self) {
-    return Token__is_other(self, "]");
+    return Token__is_other(self, ']');
 }
 
 bool Token__is_closing_paren(Token *self) {
-    return Token__is_other(self, ")");
+    return Token__is_other(self, ')');
 }
 
 bool Token__is_colon(Token *self) {
-    return Token__is_other(self, ":");
+    return Token__is_other(self, ':');
 }
 
 bool Token__is_comma(Token *self) {
-    return Token__is_other(self, ",");
+    return Token__is_other(self, ',');
 }
 
 bool Token__is_dot(Token *self) {
-    return Token__is_other(self, ".");
+    return Token__is_other(self, '.');
 }
 
 bool Token__is_equals(Token *self) {
-    return Token__is_other(self, "=");
+    return Token__is_other(self, '=');
 }
 
 bool Token__is_exclamation_mark(Token *self) {
-    return Token__is_other(self, "!");
+    return Token__is_other(self, '!');
 }
 
 bool Token__is_greater_than(Token *self) {
-    return Token__is_other(self, ">");
+    return Token__is_other(self, '>');
 }
 
 bool Token__is_hash(Token *self) {
-    return Token__is_other(self, "#");
+    return Token__is_other(self, '#');
 }
 
 bool Token__is_less_than(Token *self) {
-    return Token__is_other(self, "<");
+    return Token__is_other(self, '<');
 }
 
 bool Token__is_minus(Token *self) {
-    return Token__is_other(self, "-");
+    return Token__is_other(self, '-');
 }
 
 bool Token__is_opening_brace(Token *self) {
-    return Token__is_other(self, "{");
+    return Token__is_other(self, '{');
 }
 
 bool Token__is_opening_bracket(Token *self) {
-    return Token__is_other(self, "[");
+    return Token__is_other(self, '[');
 }
 
 bool Token__is_opening_paren(Token *self) {
-    return Token__is_other(self, "(");
+    return Token__is_other(self, '(');
 }
 
 bool Token__is_percent(Token *self) {
-    return Token__is_other(self, "%");
+    return Token__is_other(self, '%');
 }
 
 bool Token__is_plus(Token *self) {
-    return Token__is_other(self, "+");
+    return Token__is_other(self, '+');
 }
 
 bool Token__is_question_mark(Token *self) {
-    return Token__is_other(self, "?");
+    return Token__is_other(self, '?');
 }
 
 bool Token__is_semicolon(Token *self) {
-    return Token__is_other(self, ";");
+    return Token__is_other(self, ';');
 }
 
 bool Token__is_slash(Token *self) {
-    return Token__is_other(self, "/");
+    return Token__is_other(self, '/');
 }
 
 bool Token__is_vertical_bar(Token *self) {
-    return Token__is_other(self, "|");
+    return Token__is_other(self, '|');
 }
 
 bool Token__is_space(Token *self) {
@@ -310,7 +365,7 @@ void pWriter__write__token(Writer *writer, Token *token) {
             pWriter__write__cstring(writer, "\033[2;31m");
         }
     }
-    pWriter__write__string(writer, token->lexeme);
+    pWriter__write__view(writer, Token__lexeme_view(token));
     if (colored) {
         pWriter__write__cstring(writer, "\033[0m");
     }
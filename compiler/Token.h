@@ -20,78 +20,69 @@ typedef enum Token_Kind {
     TOKEN_KIND__STRING
 } Token_Kind;
 
+typedef enum Token_Keyword {
+    TOKEN_KEYWORD__NONE,
+    TOKEN_KEYWORD__AND,
+    TOKEN_KEYWORD__ANON,
+    TOKEN_KEYWORD__AS,
+    TOKEN_KEYWORD__BREAK,
+    TOKEN_KEYWORD__ELSE,
+    TOKEN_KEYWORD__ENUM,
+    TOKEN_KEYWORD__EXTERN,
+    TOKEN_KEYWORD__EXTERNAL,
+    TOKEN_KEYWORD__FALSE,
+    TOKEN_KEYWORD__FUNC,
+    TOKEN_KEYWORD__IF,
+    TOKEN_KEYWORD__LET,
+    TOKEN_KEYWORD__LOOP,
+    TOKEN_KEYWORD__MAKE,
+    TOKEN_KEYWORD__NOT,
+    TOKEN_KEYWORD__NULL,
+    TOKEN_KEYWORD__OR,
+    TOKEN_KEYWORD__RETURN,
+    TOKEN_KEYWORD__SIZEOF,
+    TOKEN_KEYWORD__STRUCT,
+    TOKEN_KEYWORD__TRAIT,
+    TOKEN_KEYWORD__TRUE,
+    TOKEN_KEYWORD__TYPE,
+    TOKEN_KEYWORD__TYPEDEF,
+    TOKEN_KEYWORD__WHILE
+} Token_Keyword;
+
+/* Fixed size token record; the lexeme is a slice of the source content */
 typedef struct Token {
     Token_Kind kind;
-    Source_Location *location;
-    String *lexeme;
-    struct Token *next_token;
+    Token_Keyword keyword;
+    uint32_t offset;
+    uint32_t length;
+    /* Trivia: the spaces in front of the token (or of its comment), and the comment in front of an end of line */
+    uint32_t leading_spaces;
+    uint32_t comment_length;
+    Source_Location location;
+    union {
+        /* Identifiers and keywords */
+        String *lexeme;
+        /* Integers */
+        uint64_t integer_value;
+        /* Characters, and the only char of other tokens */
+        char character_value;
+        /* Strings */
+        bool has_escapes;
+    };
 } Token;
 
-Token *Token__create_kind(Token_Kind kind, size_t kind_size, Source_Location *location, String *lexeme);
+Token *Token__create_copy(Token *other);
 
-typedef struct Character_Token {
-    Token super;
-    char value;
-} Character_Token;
+/* Fills the keyword hash table, and panics if two keywords have the same hash */
+void Token__init();
 
-Character_Token *Character_Token__create(Source_Location *location, String *lexeme, char value);
+/* Returns TOKEN_KEYWORD__NONE if the lexeme is not a keyword */
+Token_Keyword Token_Keyword__find(String_View lexeme);
 
-typedef struct Comment_Token {
-    Token super;
-} Comment_Token;
+String_View Token__lexeme_view(Token *self);
 
-Comment_Token *Comment_Token__create(Source_Location *location, String *lexeme);
-
-typedef struct End_Of_File_Token {
-    Token super;
-} End_Of_File_Token;
-
-End_Of_File_Token *End_Of_File_Token__create(Source_Location *location, String *lexeme);
-
-typedef struct End_Of_Line_Token {
-    Token super;
-} End_Of_Line_Token;
-
-End_Of_Line_Token *End_Of_Line_Token__create(Source_Location *location, String *lexeme);
-
-typedef struct Error_Token {
-    Token super;
-} Error_Token;
-
-Error_Token *Error_Token__create(Source_Location *location, String *lexeme);
-
-typedef struct Identifier_Token {
-    Token super;
-} Identifier_Token;
-
-Identifier_Token *Identifier_Token__create(Source_Location *location, String *lexeme);
-
-typedef struct Integer_Token {
-    Token super;
-    uint64_t value;
-} Integer_Token;
-
-Integer_Token *Integer_Token__create(Source_Location *location, String *lexeme, uint64_t value);
-
-typedef struct Other_Token {
-    Token super;
-} Other_Token;
-
-Other_Token *Other_Token__create(Source_Location *location, String *lexeme);
-
-typedef struct Space_Token {
-    Token super;
-    uint16_t count;
-} Space_Token;
-
-Space_Token *Space_Token__create(Source_Location *location, String *lexeme, uint16_t count);
-
-typedef struct String_Token {
-    Token super;
-    String *value;
-} String_Token;
-
-String_Token *String_Token__create(Source_Location *location, String *lexeme, String *value);
+/* Returns the unescaped value of a string token, which is copied only if it contains escapes */
+String *Token__create_string_value(Token *self);
 
 bool Token__is_ampersand(Token *self);
 bool Token__is_and(Token *self);
@@ -124,7 +115,7 @@ bool Token__is_hash(Token *self);
 bool Token__is_identifier(Token *self);
 bool Token__is_if(Token *self);
 bool Token__is_integer(Token *self);
-bool Token__is_keyword(Token *self, char *lexeme);
+bool Token__is_keyword(Token *self, Token_Keyword keyword);
 bool Token__is_less_than(Token *self);
 bool Token__is_let(Token *self);
 bool Token__is_loop(Token *self);
@@ -136,7 +127,7 @@ bool Token__is_opening_brace(Token *self);
 bool Token__is_opening_bracket(Token *self);
 bool Token__is_opening_paren(Token *self);
 bool Token__is_or(Token *self);
-bool Token__is_other(Token *self, char *lexeme);
+bool Token__is_other(Token *self, char lexeme);
 bool Token__is_percent(Token *self);
 bool Token__is_plus(Token *self);
 bool Token__is_question_mark(Token *self);
@@ -0,0 +1,166 @@
+/* Copyright (C) 2024 Stefan Selariu */
+
+#include "Worker.h"
+#include "File.h"
+
+#include <pthread.h>
+#include <setjmp.h>
+#include <unistd.h>
+
+static _Thread_local jmp_buf *current_task_exit = NULL;
+
+/* Ends the current task, or the process when there is none */
+static void Worker__exit() __attribute__((noreturn));
+static void Worker__exit() {
+    if (current_task_exit == NULL) {
+        exit(1);
+    }
+    longjmp(*current_task_exit, 1);
+}
+
+void Builtins__panic(const char *file, int line) {
+    if (current_task_exit == NULL) {
+        fprintf(stderr, "%s:%d: \033[0;91mPanic!\033[0m\n", file, line);
+        exit(1);
+    }
+    pWriter__write__cstring(stderr_writer, (char *)file);
+    pWriter__write__char(stderr_writer, ':');
+    pWriter__write__int64(stderr_writer, line);
+    pWriter__write__cstring(stderr_writer, ": \033[0;91mPanic!\033[0m\n");
+    Worker__exit();
+}
+
+void Builtins__todo(const char *file, int line, const char *message) {
+    if (current_task_exit == NULL) {
+        fprintf(stderr, "%s:%d: \033[0;95mTODO: %s\033[0m\n", file, line, message);
+        exit(1);
+    }
+    pWriter__write__cstring(stderr_writer, (char *)file);
+    pWriter__write__char(stderr_writer, ':');
+    pWriter__write__int64(stderr_writer, line);
+    pWriter__write__cstring(stderr_writer, ": \033[0;95mTODO: ");
+    pWriter__write__cstring(stderr_writer, (char *)message);
+    pWriter__write__cstring(stderr_writer, "\033[0m\n");
+    Worker__exit();
+}
+
+size_t Workers__count() {
+    static size_t workers_count = 0;
+    if (workers_count == 0) {
+        char *jobs = getenv("RECODE_JOBS");
+        long count = jobs != NULL ? atol(jobs) : sysconf(_SC_NPROCESSORS_ONLN);
+        workers_count = count > 0 ? (size_t)count : 1;
+    }
+    return workers_count;
+}
+
+static void Worker__run_task(Worker_Task *task) {
+    Writer *other_stderr_writer = stderr_writer;
+    task->diagnostics = String__create();
+    stderr_writer = String__create_writer(task->diagnostics);
+
+    jmp_buf *other_task_exit = current_task_exit;
+    jmp_buf task_exit;
+    current_task_exit = &task_exit;
+    if (setjmp(task_exit) == 0) {
+        task->run(task->data);
+        task->has_failed = false;
+    } else {
+        task->has_failed = true;
+    }
+    current_task_exit = other_task_exit;
+
+    pWriter__destroy(stderr_writer);
+    stderr_writer = other_stderr_writer;
+}
+
+typedef struct Workers {
+    Worker_Task *tasks;
+    size_t tasks_count;
+    size_t next_task_index;
+} Workers;
+
+static void Workers__run_tasks(Workers *self) {
+    while (true) {
+        size_t task_index = __atomic_fetch_add(&self->next_task_index, 1, __ATOMIC_RELAXED);
+        if (task_index >= self->tasks_count) {
+            break;
+        }
+        Worker__run_task(&self->tasks[task_index]);
+    }
+}
+
+typedef struct Worker {
+    pthread_t thread;
+    Workers *workers;
+    /* The arenas of the worker thread, handed over when it ends */
+    Arena *source_arena;
+    Arena *parse_arena;
+    Arena *check_arena;
+    Arena *generate_arena;
+} Worker;
+
+static void *Worker__main(Worker *self) {
+    Arena__init();
+    Workers__run_tasks(self->workers);
+    self->source_arena = source_arena;
+    self->parse_arena = parse_arena;
+    self->check_arena = check_arena;
+    self->generate_arena = generate_arena;
+    return NULL;
+}
+
+bool Workers__run(Worker_Task *tasks, size_t tasks_count) {
+    Workers workers = {.tasks = tasks, .tasks_count = tasks_count, .next_task_index = 0};
+
+    /* The calling thread runs tasks too, and the tasks of a task run only on its thread */
+    size_t threads_count = (Workers__count() < tasks_count ? Workers__count() : tasks_count);
+    threads_count = threads_count > 0 && current_task_exit == NULL ? threads_count - 1 : 0;
+    Worker *threads = (Worker *)malloc((threads_count + 1) * sizeof(Worker));
+    for (size_t index = 0; index < threads_count; index++) {
+        threads[index].workers = &workers;
+        if (pthread_create(&threads[index].thread, NULL, (void *(*)(void *))Worker__main, &threads[index]) != 0) {
+            threads_count = index;
+            break;
+        }
+    }
+    Workers__run_tasks(&workers);
+    for (size_t index = 0; index < threads_count; index++) {
+        Worker *worker = &threads[index];
+        pthread_join(worker->thread, NULL);
+
+        /* What the tasks allocated lives as long as the arenas of the calling thread */
+        Arena__adopt(source_arena, worker->source_arena);
+        Arena__adopt(parse_arena, worker->parse_arena);
+        Arena__adopt(check_arena, worker->check_arena);
+        Arena__adopt(generate_arena, worker->generate_arena);
+    }
+    free(threads);
+
+    for (size_t index = 0; index < tasks_count; index++) {
+        if (tasks[index].has_failed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Workers__report(Worker_Task *tasks, size_t tasks_count) {
+    for (size_t index = 0; index < tasks_count; index++) {
+        Worker_Task *task = &tasks[index];
+        pWriter__write__string(stderr_writer, task->diagnostics);
+        String__delete(task->diagnostics);
+        task->diagnostics = NULL;
+        if (task->has_failed) {
+            pWriter__flush(stderr_writer);
+            Worker__exit();
+        }
+    }
+}
+
+void Workers__discard(Worker_Task *tasks, size_t tasks_count) {
+    for (size_t index = 0; index < tasks_count; index++) {
+        String__delete(tasks[index].diagnostics);
+        tasks[index].diagnostics = NULL;
+    }
+}
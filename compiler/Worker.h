@@ -0,0 +1,35 @@
+/* Copyright (C) 2024 Stefan Selariu */
+
+#ifndef __WORKER_H__
+#define __WORKER_H__
+
+#include "String.h"
+
+typedef struct Worker_Task {
+    void (*run)(void *data);
+    void *data;
+    /* Whatever the task writes to stderr_writer, including its panic message */
+    String *diagnostics;
+    bool has_failed;
+} Worker_Task;
+
+/* The number of threads that run tasks: RECODE_JOBS if set, or the number of online cores */
+size_t Workers__count();
+
+/*
+ * Runs the tasks on worker threads, each thread with its own phase arenas, which are taken over
+ * by the arenas of the calling thread at the end. Returns false if any of the tasks failed.
+ */
+bool Workers__run(Worker_Task *tasks, size_t tasks_count);
+
+/*
+ * Writes the diagnostics of the tasks to stderr_writer in task order, and exits (or fails the
+ * current task) after the first failed task, so the output is the same as running the tasks one
+ * after another.
+ */
+void Workers__report(Worker_Task *tasks, size_t tasks_count);
+
+/* Drops the diagnostics of the tasks */
+void Workers__discard(Worker_Task *tasks, size_t tasks_count);
+
+#endif
@@ -2,45 +2,83 @@
 
 #include "Writer.h"
 
-Writer *Writer__create(void *object, void (*write_char)(void *object, char c)) {
+Writer *Writer__create(void *object, void (*write_bytes)(void *object, const char *bytes, size_t length), size_t buffer_size) {
     Writer *writer = malloc(sizeof(Writer));
     writer->object = object;
-    writer->write_char = write_char;
+    writer->write_bytes = write_bytes;
+    writer->buffer = buffer_size > 0 ? (char *)malloc(buffer_size) : NULL;
+    writer->buffer_size = buffer_size;
+    writer->buffer_length = 0;
     return writer;
 }
 
 void pWriter__destroy(Writer *self) {
+    pWriter__flush(self);
+    free(self->buffer);
     free(self);
 }
 
-Writer *pWriter__write__char(Writer *self, char c) {
-    self->write_char(self->object, c);
+Writer *pWriter__flush(Writer *self) {
+    if (self->buffer_length > 0) {
+        /* Emptied first, so a failed write isn't written again by the exit flush */
+        size_t buffer_length = self->buffer_length;
+        self->buffer_length = 0;
+        self->write_bytes(self->object, self->buffer, buffer_length);
+    }
     return self;
 }
 
-Writer *pWriter__write__cstring(Writer *self, char *cstring) {
-    while (*cstring) {
-        self->write_char(self->object, *cstring);
-        cstring++;
+Writer *pWriter__write__bytes(Writer *self, const char *bytes, size_t length) {
+    if (length == 0) {
+        return self;
+    }
+    if (self->buffer_length + length > self->buffer_size) {
+        pWriter__flush(self);
+        if (length >= self->buffer_size) {
+            self->write_bytes(self->object, bytes, length);
+            return self;
+        }
     }
+    memcpy(self->buffer + self->buffer_length, bytes, length);
+    self->buffer_length = self->buffer_length + length;
     return self;
 }
 
+Writer *pWriter__write__char(Writer *self, char c) {
+    if (self->buffer_length < self->buffer_size) {
+        self->buffer[self->buffer_length] = c;
+        self->buffer_length = self->buffer_length + 1;
+        return self;
+    }
+    return pWriter__write__bytes(self, &c, 1);
+}
+
+Writer *pWriter__write__cstring(Writer *self, char *cstring) {
+    return pWriter__write__bytes(self, cstring, strlen(cstring));
+}
+
 Writer *pWriter__write__int64(Writer *self, int64_t value) {
-    char buffer[21];
-    sprintf(buffer, "%ld", value);
-    return pWriter__write__cstring(self, buffer);
+    if (value < 0) {
+        pWriter__write__char(self, '-');
+        /* Negated as unsigned, so that INT64_MIN doesn't overflow */
+        return pWriter__write__uint64(self, -(uint64_t)value);
+    }
+    return pWriter__write__uint64(self, (uint64_t)value);
 }
 
 Writer *pWriter__write__uint64(Writer *self, uint64_t value) {
-    char buffer[21];
-    sprintf(buffer, "%lu", value);
-    return pWriter__write__cstring(self, buffer);
+    char buffer[20];
+    size_t index = sizeof(buffer);
+    do {
+        index = index - 1;
+        buffer[index] = (char)('0' + value % 10);
+        value = value / 10;
+    } while (value > 0);
+    return pWriter__write__bytes(self, buffer + index, sizeof(buffer) - index);
 }
 
 Writer *pWriter__end_line(Writer *self) {
-    self->write_char(self->object, '\n');
-    return self;
+    return pWriter__write__char(self, '\n');
 }
 
 Writer *pWriter__style(Writer *self, Writer_Style style) {
@@ -7,13 +7,20 @@
 
 typedef struct Writer {
     void *object;
-    void (*write_char)(void *object, char c);
+    void (*write_bytes)(void *object, const char *bytes, size_t length);
+    char *buffer;
+    size_t buffer_size;
+    size_t buffer_length;
 } Writer;
 
-Writer *Writer__create(void *object, void (*write_char)(void *object, char c));
+/* Writers with a zero buffer_size pass every write straight to write_bytes */
+Writer *Writer__create(void *object, void (*write_bytes)(void *object, const char *bytes, size_t length), size_t buffer_size);
 
 void pWriter__destroy(Writer *self);
 
+Writer *pWriter__flush(Writer *self);
+
+Writer *pWriter__write__bytes(Writer *self, const char *bytes, size_t length);
 Writer *pWriter__write__char(Writer *self, char c);
 Writer *pWriter__write__cstring(Writer *self, char *cstring);
 Writer *pWriter__write__int64(Writer *self, int64_t value);
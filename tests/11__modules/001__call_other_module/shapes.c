@@ -0,0 +1,30 @@
+#include "modules.h"
+
+struct Shape *__make_Shape_value(struct Shape value) {
+    struct Shape *result = (struct Shape *)malloc(sizeof(struct Shape));
+    *result = value;
+    return result;
+}
+
+struct Square *__make_Square_value(struct Square value) {
+    struct Square *result = (struct Square *)malloc(sizeof(struct Square));
+    *result = value;
+    return result;
+}
+
+#line 8 "tests/11__modules/001__call_other_module/shapes.code"
+int32_t pSquare__area(struct Square *self) {
+#line 9 "tests/11__modules/001__call_other_module/shapes.code"
+    return self->side * self->side;
+}
+
+#line 13 "tests/11__modules/001__call_other_module/shapes.code"
+struct Shape *make_square__0_side(int32_t side) {
+#line 14 "tests/11__modules/001__call_other_module/shapes.code"
+    counter = counter + 1;
+#line 15 "tests/11__modules/001__call_other_module/shapes.code"
+    struct Square *square = __make_Square_value((struct Square){.side = side});
+#line 16 "tests/11__modules/001__call_other_module/shapes.code"
+    return __make_Shape_value((struct Shape){.self = square, .area = (int32_t (*)(void *self)) pSquare__area});
+}
+
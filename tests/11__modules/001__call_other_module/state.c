@@ -0,0 +1,3 @@
+#include "modules.h"
+
+int32_t counter;
@@ -0,0 +1,22 @@
+#include "modules.h"
+
+#line 1 "tests/11__modules/001__call_other_module/test.code"
+int32_t main() {
+#line 2 "tests/11__modules/001__call_other_module/test.code"
+    counter = 0;
+#line 3 "tests/11__modules/001__call_other_module/test.code"
+    struct Shape *shape = make_square__0_side(10);
+#line 4 "tests/11__modules/001__call_other_module/test.code"
+    if (shape->area(shape->self) != 100) {
+#line 5 "tests/11__modules/001__call_other_module/test.code"
+        return 1;
+    }
+#line 7 "tests/11__modules/001__call_other_module/test.code"
+    if (counter != 1) {
+#line 8 "tests/11__modules/001__call_other_module/test.code"
+        return 2;
+    }
+#line 10 "tests/11__modules/001__call_other_module/test.code"
+    return 0;
+}
+